@@ -17,6 +17,8 @@
 #ifndef __PMSIS_CLUSTER_CL_MALLOC_H__
 #define __PMSIS_CLUSTER_CL_MALLOC_H__
 
+#include "pmsis/pmsis_types.h"
+
 /**
  * @addtogroup MemAlloc
  * @{
@@ -100,6 +102,139 @@ static inline void pi_cl_l2_free_wait(pi_cl_free_req_t *req);
  * @} CL_L2_Malloc
  */
 
+/**
+ * @defgroup CL_Arena CL Arena allocation
+ *
+ * \brief Lock-free arena allocation from cluster cores.
+ *
+ * An arena is a memory area reserved in L2 or in HyperRAM from FC side
+ * before a cluster task is sent. Cluster cores can then allocate from it
+ * without any delegation to the FC. Allocated chunks are not freed one by one,
+ * the whole arena is released at once, typically at the end of the task.
+ *
+ * This is intended for per-tile temporary buffers, which would otherwise cost
+ * one FC round-trip for each pi_cl_l2_malloc or pi_cl_hyperram_alloc call.
+ *
+ * @addtogroup CL_Arena
+ * @{
+ */
+
+/**
+ * \brief Cluster arena structure.
+ *
+ * This structure is used by the runtime to manage an arena.
+ * It must be instantiated once for each arena and must be kept alive until
+ * the arena is deinitialized. As it is accessed by the cluster cores, it
+ * should be instantiated in a memory visible from the cluster, for example as
+ * a global variable or through pi_l2_malloc.
+ */
+typedef struct pi_cl_arena_s pi_cl_arena_t;
+
+/**
+ * \brief Reserve an arena in L2 memory.
+ *
+ * This allocates the memory of the arena in L2 from FC side, so that it can
+ * then be used from cluster side.
+ *
+ * \param arena          Arena structure to initialize.
+ * \param size           Size in bytes of the arena.
+ *
+ * \retval 0             If operation is successful.
+ * \retval -1            If there was not enough memory available.
+ */
+int pi_cl_arena_l2_init(pi_cl_arena_t *arena, uint32_t size);
+
+/**
+ * \brief Reserve an arena in HyperRAM.
+ *
+ * This allocates the memory of the arena in the specified HyperRAM from FC
+ * side, so that it can then be used from cluster side.
+ * The chunks allocated from such an arena are HyperRAM addresses.
+ *
+ * \param arena          Arena structure to initialize.
+ * \param device         HyperRAM device where to allocate memory.
+ * \param size           Size in bytes of the arena.
+ *
+ * \retval 0             If operation is successful.
+ * \retval -1            If there was not enough memory available.
+ */
+int pi_cl_arena_hyperram_init(pi_cl_arena_t *arena, struct pi_device *device,
+                              uint32_t size);
+
+/**
+ * \brief Release the memory reserved for an arena.
+ *
+ * This gives back to the L2 or HyperRAM allocator the memory reserved when
+ * the arena was initialized. It must be called from FC side, when no cluster
+ * task is using the arena anymore.
+ *
+ * \param arena          Arena structure.
+ */
+void pi_cl_arena_deinit(pi_cl_arena_t *arena);
+
+/**
+ * \brief Allocate memory from an arena from cluster side.
+ *
+ * The allocated memory is 4-bytes aligned.
+ * This can be called concurrently by all the cores of the cluster, the
+ * allocation is done locally with an atomic update of the arena, without
+ * any delegation to the FC.
+ *
+ * \param arena          Arena structure.
+ * \param size           Size in bytes of the memory to be allocated.
+ * \param chunk          Pointer to the variable where the address of the
+ *                       allocated chunk is stored.
+ *
+ * \retval 0             If operation is successful.
+ * \retval -1            If there is not enough memory left in the arena.
+ */
+static inline int pi_cl_arena_alloc(pi_cl_arena_t *arena, uint32_t size,
+                                    uint32_t *chunk);
+
+/**
+ * \brief Release all the chunks allocated from an arena.
+ *
+ * This releases at once all the chunks allocated from the arena, which can
+ * then be used again for new allocations. This can be called from cluster or
+ * FC side, and must only be called when no other core is using chunks
+ * allocated from the arena, typically at the end of the cluster task after a
+ * barrier. This is also where the high-water mark returned by
+ * pi_cl_arena_high_water is updated with the usage before the reset.
+ *
+ * \param arena          Arena structure.
+ */
+static inline void pi_cl_arena_reset(pi_cl_arena_t *arena);
+
+/**
+ * \brief Return the number of bytes allocated from an arena.
+ *
+ * This can be used to tune the size of the arena.
+ *
+ * \param arena          Arena structure.
+ *
+ * \return               Size in bytes currently allocated.
+ */
+static inline uint32_t pi_cl_arena_used(pi_cl_arena_t *arena);
+
+/**
+ * \brief Return the maximum number of bytes ever allocated from an arena.
+ *
+ * This is the maximum usage observed since the arena was initialized, across
+ * all the calls to pi_cl_arena_reset, and can be used to tune the size of the
+ * arena. To keep allocations lock-free, the recorded mark is only updated by
+ * pi_cl_arena_reset, and this returns the largest of that mark and the
+ * current usage.
+ *
+ * \param arena          Arena structure.
+ *
+ * \return               Size in bytes.
+ */
+static inline uint32_t pi_cl_arena_high_water(pi_cl_arena_t *arena);
+
+/**
+ * @} CL_Arena
+ */
+
 /**
  * @} MemAlloc
  */
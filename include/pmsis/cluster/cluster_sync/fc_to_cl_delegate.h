@@ -176,6 +176,262 @@ static inline int pi_cluster_send_task_async(struct pi_device *device,
         struct pi_cluster_task *cluster_task,
         pi_task_t *task);
 
+/** \struct pi_cluster_warm_buffer
+ * \brief Buffer preloaded while the cluster is powering up.
+ */
+struct pi_cluster_warm_buffer {
+    void *ext;      /*!< Address of the data in L2. */
+    void *loc;      /*!< Address in cluster L1 where the data is copied. If it
+      is NULL, the buffer is allocated in L1 by the runtime and its address is
+      stored here. It must then be freed with pi_cl_l1_free. As any L1
+      allocation, it prevents the automatic power-down of the cluster until it
+      is freed. */
+    uint32_t size;  /*!< Size in bytes of the buffer. */
+};
+
+/** \struct pi_cluster_warm_conf
+ * \brief Cluster warm-up configuration structure.
+ */
+struct pi_cluster_warm_conf {
+    struct pi_cluster_warm_buffer *buffers; /*!< Array of buffers to preload,
+      can be NULL. */
+    int nb_buffers;                         /*!< Number of buffers. */
+    void (*entry)(void *arg);               /*!< Warm-up entry point executed
+      on the cluster controller core, can be NULL. */
+    void *arg;                              /*!< Argument of the entry point.
+      */
+};
+
+/** \brief Open, power-up and warm up the cluster.
+ *
+ * This is the same as pi_cluster_open, except that, as soon as the cluster
+ * memory is available, the declared buffers are preloaded into L1 with the
+ * cluster DMA, and the warm-up entry point is executed, for example to run
+ * the first kernels on a tiny input in order to fill the instruction cache.
+ * The first real task then runs at steady-state speed.
+ * The caller is blocked until the cluster is powered up, the buffers are
+ * loaded and the warm-up entry point has returned.
+ *
+ * \param device    A pointer to the device structure of the device to open.
+ * \param conf      A pointer to the warm-up configuration.
+ * \return          0 if the operation is successfull, -1 if there was an error.
+ */
+int pi_cluster_open_warm(struct pi_device *device,
+        struct pi_cluster_warm_conf *conf);
+
+/** \brief Open, power-up and warm up the cluster asynchronously.
+ *
+ * This is the same as pi_cluster_open_warm, except that the caller is not
+ * blocked and can prepare the first task while the cluster is powering up.
+ * Tasks sent before the end of the warm-up are executed after it.
+ *
+ * \param device    A pointer to the device structure of the device to open.
+ * \param conf      A pointer to the warm-up configuration. It must be kept
+ *   alive until the task is pushed.
+ * \param task      The task used to notify the end of the warm-up.
+ * \return          0 if the operation is successfull, -1 if there was an error.
+ */
+int pi_cluster_open_warm_async(struct pi_device *device,
+        struct pi_cluster_warm_conf *conf, pi_task_t *task);
+
+/** \struct pi_cluster_pm_stats
+ * \brief Cluster power management statistics.
+ */
+struct pi_cluster_pm_stats {
+    uint32_t opens;        /*!< Number of times the cluster was powered up. */
+    uint32_t closes;       /*!< Number of times the cluster was powered
+      down. */
+    uint32_t open_avg_us;  /*!< Average duration of a power-up. */
+    uint32_t close_avg_us; /*!< Average duration of a power-down. */
+    uint64_t on_us;        /*!< Total time the cluster was powered up. */
+    uint64_t busy_us;      /*!< Total time the cluster was executing tasks. */
+    uint32_t held_closes;  /*!< Number of power-downs which were delayed
+      because L1 memory was still reserved. */
+};
+
+/** \brief Enable automatic power management of the cluster.
+ *
+ * Once enabled, the cluster is automatically powered up when a task is sent
+ * with pi_cluster_send_task or pi_cluster_send_task_async while it is off,
+ * and is kept powered up across back-to-back tasks. It is only powered down
+ * once it has been idle for the specified timeout. This avoids paying the
+ * full power-up cost for each task without keeping the cluster on forever.
+ *
+ * If prediction is enabled, the runtime also measures the interval between
+ * bursts of tasks, powers the cluster down immediately when the next burst is
+ * not expected before the timeout, and starts powering it up in advance when
+ * the next burst is expected soon.
+ *
+ * As powering the cluster down loses the content of its L1 memory, the
+ * cluster is never powered down automatically while L1 memory is reserved,
+ * i.e. while chunks allocated with pi_cl_l1_malloc or
+ * pi_cl_l1_malloc_align, L1 arenas or reserved task plans have not been
+ * released. The power-down is then delayed until the last reservation is
+ * released and the cluster has been idle for the timeout. L1 data which must
+ * survive a power-down must thus be kept in L2 and reloaded by the tasks.
+ *
+ * The cluster device stays opened while it is powered down, so the functions
+ * accessing its L1 memory from the FC side, i.e. pi_cl_l1_malloc,
+ * pi_cl_l1_malloc_align, pi_cl_l1_arena_init, pi_cluster_task_plan_reserve
+ * and pi_cluster_open_warm, can still be called. They first power the cluster
+ * up, which is counted in the opens statistic, and as they then reserve L1
+ * memory, the cluster stays powered up until it is released.
+ *
+ * The cluster device must have been opened with pi_cluster_open. Calling
+ * pi_cluster_close disables automatic power management.
+ *
+ * \param device          A pointer to the structure describing the device.
+ * \param idle_timeout_us Idle time after which the cluster is powered down.
+ * \param predict         1 to enable prediction of the next use, 0 to only
+ *   use the timeout.
+ * \return                0 if the operation is successfull, -1 if there was
+ *   an error.
+ */
+int pi_cluster_pm_enable(struct pi_device *device, uint32_t idle_timeout_us,
+        int predict);
+
+/** \brief Disable automatic power management of the cluster.
+ *
+ * The cluster is powered up if it was down, and then stays powered up until
+ * pi_cluster_close is called.
+ *
+ * \param device    A pointer to the structure describing the device.
+ */
+void pi_cluster_pm_disable(struct pi_device *device);
+
+/** \brief Get the cluster power management statistics.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param stats     A pointer to the structure where the statistics are
+ *   stored.
+ */
+void pi_cluster_pm_stats_get(struct pi_device *device,
+        struct pi_cluster_pm_stats *stats);
+
+/** \struct pi_cluster_l1_buffer
+ * \brief Named L1 buffer reserved by a task plan.
+ */
+struct pi_cluster_l1_buffer {
+    const char *name; /*!< Name of the buffer, used to retrieve it. */
+    uint32_t size;    /*!< Size in bytes of the buffer. */
+    uint32_t align;   /*!< Alignment in bytes of the buffer, must be a power
+      of 2, or 0 for the default alignment. */
+    void *addr;       /*!< Address of the buffer in L1, filled by
+      pi_cluster_task_plan_reserve. */
+};
+
+/** \struct pi_cluster_task_plan
+ * \brief Cluster task L1 plan.
+ *
+ * This structure describes everything a cluster task needs in L1, i.e. the
+ * stacks of the cores and the task buffers, so that it can be reserved as a
+ * single contiguous block instead of competing with pi_cl_l1_malloc.
+ */
+struct pi_cluster_task_plan {
+    uint32_t stack_size;       /*!< Stack size of the cluster controller
+      core, or 0 for the default size. */
+    uint32_t slave_stack_size; /*!< Stack size of each slave core, or 0 for
+      the default size. */
+    int nb_cores;              /*!< Number of cores used by the task,
+      including the cluster controller, or 0 for all cores. */
+    struct pi_cluster_l1_buffer *buffers; /*!< Array of buffers, can be NULL.
+      */
+    int nb_buffers;            /*!< Number of buffers. */
+    int measure;               /*!< If 1, the stacks are filled with a pattern
+      when the plan is applied to a task, so that their high-water mark can be
+      measured with pi_cluster_task_plan_stack_usage. */
+    uint32_t total_size;       /*!< Total size of the L1 block, filled by
+      pi_cluster_task_plan_reserve. */
+};
+
+/** \brief Initialize a task plan with default values.
+ *
+ * \param plan      A pointer to the task plan.
+ */
+void pi_cluster_task_plan_init(struct pi_cluster_task_plan *plan);
+
+/** \brief Compute the L1 size of a task plan.
+ *
+ * This returns the size of the contiguous L1 block needed by the plan,
+ * including the stacks, the buffers and their alignment padding, without
+ * reserving anything. This can be used to compute how much L1 is left for
+ * bigger tiles.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param plan      A pointer to the task plan.
+ * \return          The size in bytes of the L1 block.
+ */
+uint32_t pi_cluster_task_plan_size(struct pi_device *device,
+        struct pi_cluster_task_plan *plan);
+
+/** \brief Reserve the L1 block of a task plan.
+ *
+ * This allocates the stacks and the buffers of the plan as a single
+ * contiguous block in the cluster L1 and fills the address of each buffer.
+ * The block stays reserved until pi_cluster_task_plan_release is called, so
+ * that the same plan can be applied to several tasks. While it is reserved,
+ * automatic power management does not power the cluster down, so that the
+ * content of the buffers is kept between tasks.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param plan      A pointer to the task plan.
+ * \return          0 if the operation is successfull, -1 if there was not
+ *   enough L1 memory.
+ */
+int pi_cluster_task_plan_reserve(struct pi_device *device,
+        struct pi_cluster_task_plan *plan);
+
+/** \brief Release the L1 block of a task plan.
+ *
+ * No task using this plan must be pending or running.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param plan      A pointer to the task plan.
+ */
+void pi_cluster_task_plan_release(struct pi_device *device,
+        struct pi_cluster_task_plan *plan);
+
+/** \brief Apply a task plan to a cluster task.
+ *
+ * This sets the stacks, stack sizes and number of cores of the task from the
+ * plan, which must have been reserved. This must be called after
+ * pi_cluster_task and before the task is sent.
+ *
+ * \param task      A pointer to the cluster task.
+ * \param plan      A pointer to the task plan.
+ */
+void pi_cluster_task_plan_apply(struct pi_cluster_task *task,
+        struct pi_cluster_task_plan *plan);
+
+/** \brief Get the address of a plan buffer from its name.
+ *
+ * This can be called from the cluster side as well.
+ *
+ * \param plan      A pointer to the task plan.
+ * \param name      The name of the buffer.
+ * \return          The address of the buffer in L1, or NULL if no buffer has
+ *   this name.
+ */
+void *pi_cluster_task_plan_buffer(struct pi_cluster_task_plan *plan,
+        const char *name);
+
+/** \brief Get the stack high-water marks of a task plan.
+ *
+ * This returns the maximum stack usage observed since the plan was last
+ * applied to a task with measuring enabled. This should be called once the
+ * task has finished execution, and can be used to shrink the stack sizes.
+ *
+ * \param plan        A pointer to the task plan.
+ * \param master_used Where the maximum stack usage of the cluster controller
+ *   core is stored.
+ * \param slave_used  Where the maximum stack usage of all the slave cores is
+ *   stored.
+ * \return            0 if the operation is successfull, -1 if measuring was
+ *   not enabled.
+ */
+int pi_cluster_task_plan_stack_usage(struct pi_cluster_task_plan *plan,
+        uint32_t *master_used, uint32_t *slave_used);
+
 //!@}
 
 /**
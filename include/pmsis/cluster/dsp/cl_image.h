@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __PMSIS_CLUSTER_DSP_CL_IMAGE_H__
+#define __PMSIS_CLUSTER_DSP_CL_IMAGE_H__
+
+#include "pmsis/pmsis_types.h"
+#include "pmsis/drivers/cpi.h"
+
+/**
+ * @addtogroup clusterDriver
+ * @{
+ */
+
+/**
+ * @defgroup ClusterImage Image conversion
+ *
+ * This set of functions provides conversion of the images captured with the
+ * CPI interface into the formats expected by image processing and neural
+ * network code.
+ *
+ * The color-space conversion, the bilinear resize and the normalization are
+ * fused in a single pass, so that each input pixel is read only once. The
+ * kernels work on packed 8-bit and 16-bit data to use the SIMD instructions
+ * of the cluster cores, and the output lines are distributed over the
+ * cluster cores.
+ */
+
+/**
+ * @addtogroup ClusterImage
+ * @{
+ */
+
+/**@{*/
+
+/** \enum pi_cl_img_format_e
+ * \brief Output image format identifier.
+ */
+typedef enum {
+    PI_CL_IMG_FORMAT_RGB888     = 0, /*!< Interleaved 8-bit RGB. */
+    PI_CL_IMG_FORMAT_RGB_PLANAR = 1, /*!< Planar 8-bit RGB (CHW). */
+    PI_CL_IMG_FORMAT_GRAY       = 2, /*!< 8-bit luminance. */
+    PI_CL_IMG_FORMAT_CHW_INT8   = 3  /*!< Planar signed 8-bit, normalized
+      with the mean and scale of the conversion. */
+} pi_cl_img_format_e;
+
+/** \struct pi_cl_img_conv
+ * \brief Image conversion descriptor.
+ *
+ * This structure describes a conversion from a CPI format to an output
+ * format. It must be kept alive while the conversion is running.
+ *
+ * For PI_CL_IMG_FORMAT_CHW_INT8, each output value of channel c is
+ * ((pixel - mean[c]) * scale[c]) >> scale_shift, saturated to 8 bits.
+ */
+struct pi_cl_img_conv
+{
+    pi_cpi_format_e in_format;      /*!< Input format, one of RGB565, RGB555,
+      RGB444 or YUV422. */
+    uint16_t in_width;              /*!< Input width in pixels. */
+    uint16_t in_height;             /*!< Input height in pixels. */
+    uint32_t in_stride;             /*!< Number of bytes between 2 input lines.
+      If it is zero, lines are contiguous. */
+    pi_cl_img_format_e out_format;  /*!< Output format. */
+    uint16_t out_width;             /*!< Output width in pixels. If different
+      from the input one, the image is resized with bilinear interpolation. */
+    uint16_t out_height;            /*!< Output height in pixels. */
+    int16_t mean[3];                /*!< Per-channel mean subtracted for
+      PI_CL_IMG_FORMAT_CHW_INT8. */
+    uint16_t scale[3];              /*!< Per-channel scale for
+      PI_CL_IMG_FORMAT_CHW_INT8. */
+    uint8_t scale_shift;            /*!< Right shift applied after scaling. */
+    uint8_t nb_cores;               /*!< Number of cluster cores used by
+      pi_cl_img_convert. If it is zero, all the cores are used. */
+};
+
+/** \brief Initialize an image conversion with default values.
+ *
+ * The default conversion is an RGB565 to RGB888 conversion without resize nor
+ * normalization.
+ *
+ * \param conv A pointer to the conversion descriptor.
+ */
+void pi_cl_img_conv_init(struct pi_cl_img_conv *conv);
+
+/** \brief Convert a full image.
+ *
+ * This must be called by the cluster controller core. The output lines are
+ * distributed over the configured number of cores with pi_cl_team_fork. The
+ * caller is blocked until the whole image is converted.
+ *
+ * \param conv A pointer to the conversion descriptor.
+ * \param in   The input image.
+ * \param out  The output image.
+ */
+void pi_cl_img_convert(struct pi_cl_img_conv *conv, const void *in,
+  void *out);
+
+/** \brief Convert a range of output lines.
+ *
+ * This converts the specified output lines on the calling core, reading only
+ * the input lines they depend on. This can be used from an entry point
+ * already forked on the cluster cores, or to convert an image slice as soon
+ * as it is received.
+ *
+ * \param conv       A pointer to the conversion descriptor.
+ * \param in         The input image. The input lines are accessed at the
+ *   position they have in the full image, so this can point to a partial
+ *   buffer shifted by the index of its first line.
+ * \param out        The output image, accessed in the same way.
+ * \param first_line Index of the first output line to convert.
+ * \param nb_lines   Number of output lines to convert.
+ */
+void pi_cl_img_convert_lines(struct pi_cl_img_conv *conv, const void *in,
+  void *out, uint32_t first_line, uint32_t nb_lines);
+
+/** \brief Return the input lines needed for a range of output lines.
+ *
+ * This gives, taking into account the vertical resize, the range of input
+ * lines which must be available to convert the specified output lines.
+ *
+ * \param conv       A pointer to the conversion descriptor.
+ * \param first_line Index of the first output line.
+ * \param nb_lines   Number of output lines.
+ * \param in_first   Pointer to the variable storing the first input line.
+ * \param in_nb      Pointer to the variable storing the number of input lines.
+ */
+void pi_cl_img_input_lines(struct pi_cl_img_conv *conv, uint32_t first_line,
+  uint32_t nb_lines, uint32_t *in_first, uint32_t *in_nb);
+
+//!@}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif  /* __PMSIS_CLUSTER_DSP_CL_IMAGE_H__ */
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __PMSIS_CLUSTER_DSP_CL_PDM_H__
+#define __PMSIS_CLUSTER_DSP_CL_PDM_H__
+
+#include "pmsis/pmsis_types.h"
+
+/**
+ * @addtogroup clusterDriver
+ * @{
+ */
+
+/**
+ * @defgroup ClusterPDM PDM to PCM decimation
+ *
+ * This set of functions provides a software PDM to PCM conversion, for
+ * channels which can not be filtered by the I2S hardware filter.
+ *
+ * The conversion is done in two stages: a CIC decimator working directly on
+ * the 1-bit PDM stream, followed by a decimating FIR filter which compensates
+ * the CIC droop and removes the remaining out-of-band noise. The FIR kernel
+ * is working on packed 16-bit samples so that 2 taps are computed per SIMD
+ * instruction.
+ *
+ * Channels are independent and are processed in parallel by the cluster
+ * cores, one or several channels per core.
+ */
+
+/**
+ * @addtogroup ClusterPDM
+ * @{
+ */
+
+/**@{*/
+
+/** \struct pi_cl_pdm_decim_conf
+ * \brief PDM decimator configuration structure.
+ *
+ * The total decimation factor is cic_decimation * fir_decimation and
+ * should be equal to the pdm_decimation of the I2S configuration.
+ */
+struct pi_cl_pdm_decim_conf
+{
+    uint16_t nb_channels;     /*!< Number of PDM channels. */
+    uint16_t cic_decimation;  /*!< Decimation factor of the CIC stage. It must
+      be a multiple of 8. */
+    uint8_t cic_order;        /*!< Number of CIC integrator and comb stages,
+      from 1 to 5. */
+    uint8_t fir_decimation;   /*!< Decimation factor of the FIR stage. */
+    uint16_t fir_taps;        /*!< Number of FIR taps. It must be even. */
+    const int16_t *fir_coeffs;/*!< FIR coefficients in Q15. If NULL, a default
+      CIC compensation filter is used. */
+    int8_t shift;             /*!< Right shift applied to the FIR output to
+      get 16-bit PCM samples. */
+    uint8_t nb_cores;         /*!< Number of cluster cores used for the
+      processing. If it is zero, all the cores of the cluster are used. */
+};
+
+/** \brief PDM decimator structure.
+ *
+ * This structure is used by the runtime to manage a decimator. It must be
+ * instantiated once for each set of channels and kept alive until the
+ * processing is finished. As it is accessed by all the cluster cores, it
+ * should be allocated in cluster memory.
+ */
+typedef struct pi_cl_pdm_decim_s pi_cl_pdm_decim_t;
+
+/** \brief Initialize a PDM decimator configuration with default values.
+ *
+ * \param conf A pointer to the decimator configuration.
+ */
+void pi_cl_pdm_decim_conf_init(struct pi_cl_pdm_decim_conf *conf);
+
+/** \brief Return the size of the decimator state.
+ *
+ * This gives the number of bytes of the state buffer which must be given to
+ * pi_cl_pdm_decim_init, for the CIC accumulators and the FIR delay lines of
+ * all channels.
+ *
+ * \param conf A pointer to the decimator configuration.
+ * \return     The size in bytes of the state.
+ */
+uint32_t pi_cl_pdm_decim_state_size(struct pi_cl_pdm_decim_conf *conf);
+
+/** \brief Initialize a PDM decimator.
+ *
+ * The state of all channels is reset.
+ *
+ * \param decim A pointer to the decimator structure.
+ * \param conf  A pointer to the decimator configuration.
+ * \param state The state buffer. Its size must be the one returned by
+ *   pi_cl_pdm_decim_state_size and it must be kept alive until the
+ *   decimator is not used anymore. It should be allocated in cluster memory.
+ * \return      0 if the operation is successfull, -1 if the configuration is
+ *   not supported.
+ */
+int pi_cl_pdm_decim_init(pi_cl_pdm_decim_t *decim,
+  struct pi_cl_pdm_decim_conf *conf, void *state);
+
+/** \brief Convert a block of PDM samples to PCM for all channels.
+ *
+ * This must be called by the cluster controller core. The channels are
+ * processed in parallel by forking the execution on the configured number of
+ * cores with pi_cl_team_fork. The caller is blocked until all the channels
+ * are processed.
+ *
+ * \param decim  A pointer to the decimator structure.
+ * \param pdm    Array of pointers to the input PDM streams, one per channel.
+ *   Each stream contains 8 PDM samples per byte, MSB first.
+ * \param pcm    Array of pointers to the output PCM buffers, one per channel.
+ *   Each buffer must be able to contain nb_bytes * 8 / (cic_decimation *
+ *   fir_decimation) samples.
+ * \param nb_bytes Number of input bytes per channel. It must be a multiple of
+ *   cic_decimation * fir_decimation / 8.
+ */
+void pi_cl_pdm_decim_process(pi_cl_pdm_decim_t *decim, uint8_t **pdm,
+  int16_t **pcm, uint32_t nb_bytes);
+
+/** \brief Convert a block of PDM samples to PCM for one channel.
+ *
+ * This processes a single channel on the calling core, and can be used
+ * from an entry point already forked on the cluster cores, in order to fuse
+ * the decimation with other processing.
+ *
+ * \param decim  A pointer to the decimator structure.
+ * \param channel Channel ID, from 0 to the number of channels minus 1.
+ * \param pdm    Input PDM stream, 8 PDM samples per byte, MSB first.
+ * \param pcm    Output PCM buffer.
+ * \param nb_bytes Number of input bytes, with the same constraints as for
+ *   pi_cl_pdm_decim_process.
+ */
+void pi_cl_pdm_decim_process_channel(pi_cl_pdm_decim_t *decim, int channel,
+  const uint8_t *pdm, int16_t *pcm, uint32_t nb_bytes);
+
+//!@}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif  /* __PMSIS_CLUSTER_DSP_CL_PDM_H__ */
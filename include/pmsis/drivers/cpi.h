@@ -211,6 +211,112 @@ static inline void pi_cpi_set_filter(struct pi_device *device, uint32_t r_coeff,
 static inline void pi_cpi_set_slice(struct pi_device *device, uint32_t x,
   uint32_t y, uint32_t w, uint32_t h);
 
+/** \brief Callback called when a frame is complete in ring mode.
+ *
+ * \param arg        The argument given in the ring configuration.
+ * \param frame      The frame buffer. It belongs to the application until it is
+ *   given back with pi_cpi_ring_release.
+ * \param frame_id   Sequence number of the frame since the ring was started.
+ */
+typedef void (*pi_cpi_frame_cb_t)(void *arg, void *frame, uint32_t frame_id);
+
+/** \brief Callback called when a slice of lines is complete in ring mode.
+ *
+ * \param arg        The argument given in the ring configuration.
+ * \param frame      The frame buffer being filled.
+ * \param first_line Index of the first line of the slice in the frame.
+ * \param nb_lines   Number of lines of the slice.
+ */
+typedef void (*pi_cpi_slice_cb_t)(void *arg, void *frame, uint32_t first_line,
+  uint32_t nb_lines);
+
+/** \struct pi_cpi_ring_conf
+ * \brief CPI capture ring configuration structure.
+ *
+ * This structure is used to pass the desired ring configuration to the
+ * runtime when starting a continuous capture.
+ */
+struct pi_cpi_ring_conf
+{
+    void **frames;              /*!< Array of frame buffers. They must be kept
+      alive until the ring is stopped. */
+    uint32_t nb_frames;         /*!< Number of frame buffers, at least 2. */
+    uint32_t frame_size;        /*!< Size in bytes of a frame buffer. */
+    uint32_t line_size;         /*!< Size in bytes of a line, as output by the
+      interface after the window set with pi_cpi_set_slice. */
+    uint32_t slice_lines;       /*!< Number of lines after which the slice
+      callback is called. If it is zero, slice notifications are disabled. */
+    pi_cpi_frame_cb_t frame_cb; /*!< Callback called for each complete frame.
+      */
+    pi_cpi_slice_cb_t slice_cb; /*!< Callback called for each complete slice,
+      can be NULL. */
+    void *arg;                  /*!< Argument given to the callbacks. */
+};
+
+/** \struct pi_cpi_ring_stats
+ * \brief CPI capture ring statistics.
+ */
+struct pi_cpi_ring_stats
+{
+    uint32_t frames;         /*!< Number of frames delivered. */
+    uint32_t dropped_frames; /*!< Number of frames dropped because no frame
+      buffer was free. */
+};
+
+/** \brief Initialize a ring configuration with default values.
+ *
+ * \param conf A pointer to the ring configuration.
+ */
+void pi_cpi_ring_conf_init(struct pi_cpi_ring_conf *conf);
+
+/** \brief Start a continuous capture into a ring of frame buffers.
+ *
+ * In this mode, the driver cycles through the frame buffers of the
+ * configuration and re-arms the interface itself, without any gap between
+ * frames, so that no line is lost at high frame rates.
+ *
+ * Once a frame is complete, the frame callback is called and the frame belongs
+ * to the application until it is given back with pi_cpi_ring_release. If no
+ * frame buffer is free when a new frame starts, the frame is dropped.
+ *
+ * If slice_lines is not zero, the slice callback is also called each time
+ * slice_lines lines have been received, so that the processing of the top of
+ * the frame can start while the bottom is still being received.
+ *
+ * The interface must then be started with pi_cpi_control_start.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param conf      A pointer to the ring configuration. It must be kept alive
+ *   until the ring is stopped.
+ * \return          0 if it succeeded or -1 if it failed.
+ */
+int pi_cpi_ring_start(struct pi_device *device, struct pi_cpi_ring_conf *conf);
+
+/** \brief Stop a continuous capture.
+ *
+ * The capture is stopped at the end of the current frame. No callback is
+ * called after this function has returned.
+ *
+ * \param device    A pointer to the structure describing the device.
+ */
+void pi_cpi_ring_stop(struct pi_device *device);
+
+/** \brief Give back a frame buffer to the ring.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param frame     The frame buffer, as given to the frame callback.
+ */
+void pi_cpi_ring_release(struct pi_device *device, void *frame);
+
+/** \brief Get the ring statistics.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param stats     A pointer to the structure where the statistics are
+ *   stored.
+ */
+void pi_cpi_ring_stats_get(struct pi_device *device,
+  struct pi_cpi_ring_stats *stats);
+
 //!@}
 
 /**
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __PI_DRIVERS_CPI_PREPROC_H__
+#define __PI_DRIVERS_CPI_PREPROC_H__
+
+#include "pmsis/pmsis_types.h"
+#include "pmsis/drivers/cpi.h"
+#include "pmsis/cluster/dsp/cl_image.h"
+
+/**
+ * @defgroup CPIPreproc CPI preprocessing pipeline
+ * @ingroup CPI
+ *
+ * This API provides a capture pipeline which converts each frame received on
+ * the CPI interface into a tensor while it is being received. The capture
+ * ring is driven from the fabric controller, and the conversion of each slice
+ * is delegated to the cluster with the ClusterImage kernels.
+ */
+
+/**
+ * @addtogroup CPIPreproc
+ * @{
+ */
+
+/**@{*/
+
+/** \brief Callback called when a preprocessed frame is ready.
+ *
+ * \param arg      The argument given in the stage configuration.
+ * \param tensor   The output tensor containing the converted frame.
+ * \param frame_id Sequence number of the frame.
+ */
+typedef void (*pi_cpi_preproc_cb_t)(void *arg, void *tensor,
+  uint32_t frame_id);
+
+/** \struct pi_cpi_preproc_conf
+ * \brief Capture preprocessing stage configuration structure.
+ */
+struct pi_cpi_preproc_conf
+{
+    struct pi_device *cpi;          /*!< Opened CPI device. */
+    struct pi_device *cluster;      /*!< Opened cluster device. */
+    struct pi_cpi_ring_conf *ring;  /*!< Capture ring configuration. The frame
+      and slice callbacks are set by the stage. */
+    struct pi_cl_img_conv *conv;    /*!< Conversion from the captured frame to
+      the tensor. */
+    void *tensor;                   /*!< Output tensor, in L1 or L2. */
+    void *l1_buffer;                /*!< L1 buffer used for the DMA tiles. */
+    uint32_t l1_size;               /*!< Size in bytes of the L1 buffer, which
+      is split in 2 tiles for double buffering. */
+    pi_cpi_preproc_cb_t callback;   /*!< Callback called for each tensor. */
+    void *arg;                      /*!< Argument given to the callback. */
+};
+
+/** \struct pi_cpi_preproc_stats
+ * \brief Capture preprocessing stage statistics.
+ *
+ * The latency of a frame is measured end-to-end, from the start of the frame
+ * on the interface, i.e. the reception of its first line, to the moment its
+ * tensor is ready and the callback is called.
+ */
+struct pi_cpi_preproc_stats
+{
+    uint32_t frames;          /*!< Number of tensors produced. */
+    uint32_t dropped_frames;  /*!< Number of frames dropped because the
+      tensor was not released in time. */
+    uint32_t latency_min_us;  /*!< Minimum frame latency. */
+    uint32_t latency_max_us;  /*!< Maximum frame latency. */
+    uint32_t latency_avg_us;  /*!< Average frame latency. */
+};
+
+/** \brief Capture preprocessing stage structure.
+ *
+ * This structure is used by the runtime to manage a preprocessing stage. It
+ * must be kept alive until the stage is stopped.
+ */
+typedef struct pi_cpi_preproc_s pi_cpi_preproc_t;
+
+/** \brief Start a capture preprocessing stage.
+ *
+ * This starts a continuous capture with the ring of the configuration, and
+ * each time a slice of the frame is received, a cluster task fetches the
+ * corresponding input lines to L1 with the cluster DMA and converts them
+ * directly into the output tensor. There is thus no intermediate pass on the
+ * full frame, and the tensor is ready shortly after the last line is
+ * received.
+ *
+ * The tensor belongs to the application from the callback until it is given
+ * back with pi_cpi_preproc_release. If a new frame starts before that, it is
+ * dropped.
+ *
+ * This can only be called from fabric-controller side, and the interface must
+ * then be started with pi_cpi_control_start.
+ *
+ * \param stage     A pointer to the stage structure.
+ * \param conf      A pointer to the stage configuration. It must be kept
+ *   alive until the stage is stopped.
+ * \return          0 if it succeeded or -1 if it failed.
+ */
+int pi_cpi_preproc_start(pi_cpi_preproc_t *stage,
+  struct pi_cpi_preproc_conf *conf);
+
+/** \brief Stop a capture preprocessing stage.
+ *
+ * The capture ring is stopped and the caller is blocked until the last
+ * cluster task is finished.
+ *
+ * \param stage     A pointer to the stage structure.
+ */
+void pi_cpi_preproc_stop(pi_cpi_preproc_t *stage);
+
+/** \brief Give back the output tensor to a preprocessing stage.
+ *
+ * \param stage     A pointer to the stage structure.
+ */
+void pi_cpi_preproc_release(pi_cpi_preproc_t *stage);
+
+/** \brief Get the preprocessing stage statistics.
+ *
+ * \param stage     A pointer to the stage structure.
+ * \param stats     A pointer to the structure where the statistics are
+ *   stored.
+ */
+void pi_cpi_preproc_stats_get(pi_cpi_preproc_t *stage,
+  struct pi_cpi_preproc_stats *stats);
+
+//!@}
+
+/**
+ * @}
+ */
+
+#endif  /* __PI_DRIVERS_CPI_PREPROC_H__ */
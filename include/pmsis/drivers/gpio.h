@@ -198,6 +198,189 @@ void pi_gpio_pin_notif_clear(struct pi_device *device, uint32_t pin);
  */
 int pi_gpio_pin_notif_get(struct pi_device *device, uint32_t pin);
 
+/** \brief Set several GPIOs to 1.
+ *
+ * All the GPIOs of the mask are set to 1 with a single atomic access, the
+ * other GPIOs of the port are not modified. Contrary to pi_gpio_mask_write,
+ * this does not need any read-modify-write sequence.
+ *
+ * \param device         A pointer to the device structure of the GPIO port.
+ * \param mask           Mask of the GPIOs to set.
+ *
+ * \retval               0 if the operation is successfull,
+ * \retval               ERROR_CODE if there was an error.
+ */
+int pi_gpio_mask_set(struct pi_device *device, uint32_t mask);
+
+/** \brief Set several GPIOs to 0.
+ *
+ * All the GPIOs of the mask are cleared with a single atomic access, the
+ * other GPIOs of the port are not modified.
+ *
+ * \param device         A pointer to the device structure of the GPIO port.
+ * \param mask           Mask of the GPIOs to clear.
+ *
+ * \retval               0 if the operation is successfull,
+ * \retval               ERROR_CODE if there was an error.
+ */
+int pi_gpio_mask_clear(struct pi_device *device, uint32_t mask);
+
+/** \brief Toggle several GPIOs.
+ *
+ * All the GPIOs of the mask are inverted with a single atomic access, the
+ * other GPIOs of the port are not modified.
+ *
+ * \param device         A pointer to the device structure of the GPIO port.
+ * \param mask           Mask of the GPIOs to toggle.
+ *
+ * \retval               0 if the operation is successfull,
+ * \retval               ERROR_CODE if there was an error.
+ */
+int pi_gpio_mask_toggle(struct pi_device *device, uint32_t mask);
+
+/**
+ * \enum pi_gpio_wave_op_e
+ * \brief Operation of a waveform step.
+ */
+typedef enum
+{
+    PI_GPIO_WAVE_SET    = 0, /*!< Set the GPIOs of the mask. */
+    PI_GPIO_WAVE_CLEAR  = 1, /*!< Clear the GPIOs of the mask. */
+    PI_GPIO_WAVE_TOGGLE = 2, /*!< Toggle the GPIOs of the mask. */
+    PI_GPIO_WAVE_WRITE  = 3  /*!< Write the value to the GPIOs of the mask. */
+} pi_gpio_wave_op_e;
+
+/**
+ * \struct pi_gpio_wave_step_t
+ * \brief Step of a GPIO waveform.
+ */
+typedef struct pi_gpio_wave_step
+{
+    uint32_t mask;         /*!< Mask of the GPIOs modified by this step. */
+    uint32_t value;        /*!< Value used by PI_GPIO_WAVE_WRITE. */
+    uint32_t delay_ns;     /*!< Delay after this step, in nano-seconds. */
+    pi_gpio_wave_op_e op;  /*!< Operation of this step. */
+} pi_gpio_wave_step_t;
+
+/** \brief Play a GPIO waveform.
+ *
+ * The steps are executed from a tight loop with interrupts disabled, so that
+ * the delays between steps are cycle-accurate. The delays are converted to FC
+ * cycles with the current FC frequency. This is intended for bit-banged
+ * protocols. The caller is blocked until the waveform is
+ * finished.
+ *
+ * \param device         A pointer to the device structure of the GPIO port.
+ * \param steps          Array of steps.
+ * \param nb_steps       Number of steps.
+ * \param repeat         Number of times the waveform is played.
+ *
+ * \retval               0 if the operation is successfull,
+ * \retval               ERROR_CODE if there was an error.
+ */
+int pi_gpio_wave_play(struct pi_device *device, pi_gpio_wave_step_t *steps,
+                      uint32_t nb_steps, uint32_t repeat);
+
+/** \brief Play a GPIO waveform asynchronously.
+ *
+ * The steps are executed from a timer, so that the caller can continue its
+ * execution. The delays are rounded to the resolution of the timer, which is
+ * typically one micro-second.
+ * The steps must be kept alive until the waveform is finished.
+ *
+ * \param device         A pointer to the device structure of the GPIO port.
+ * \param steps          Array of steps.
+ * \param nb_steps       Number of steps.
+ * \param repeat         Number of times the waveform is played.
+ * \param task           The task used to notify the end of the waveform.
+ *
+ * \retval               0 if the operation is successfull,
+ * \retval               ERROR_CODE if there was an error.
+ */
+int pi_gpio_wave_play_async(struct pi_device *device,
+                            pi_gpio_wave_step_t *steps, uint32_t nb_steps,
+                            uint32_t repeat, pi_task_t *task);
+
+/**
+ * \struct pi_gpio_event_t
+ * \brief GPIO event.
+ *
+ * This describes one GPIO notification recorded in an event queue.
+ */
+typedef struct pi_gpio_event
+{
+    uint32_t timestamp; /*!< Time of the notification, in micro-seconds, as
+                          returned by pi_time_get_us truncated to 32 bits. */
+    uint8_t pin;        /*!< The GPIO number within the port. */
+    uint8_t value;      /*!< Value of the GPIO after the edge, 1 for a rising
+                          edge and 0 for a falling edge. */
+} pi_gpio_event_t;
+
+/** \struct pi_gpio_event_queue_conf
+ * \brief GPIO event queue configuration structure.
+ */
+struct pi_gpio_event_queue_conf
+{
+    pi_gpio_event_t *events; /*!< Array used to store the events. It must be
+                               kept alive until the queue is stopped. */
+    uint32_t nb_events;      /*!< Number of events the array can contain. */
+    uint32_t mask;           /*!< Mask of the GPIOs to record. */
+    pi_gpio_notif_e flags;   /*!< Edges to record. */
+    callback_t callback;     /*!< Callback called when the queue becomes non
+                               empty. Can be NULL. */
+    void *arg;               /*!< Argument given to the callback. */
+};
+
+/** \brief Start recording GPIO notifications into an event queue.
+ *
+ * Once started, every notification of the GPIOs of the mask is recorded
+ * with its timestamp into the event queue, directly from the interrupt
+ * handler. Contrary to tasks attached to GPIOs, the recording stays armed
+ * after each notification so that no edge is lost between two reads of the
+ * queue. The queue is a lock-free ring, the interrupt handler being the only
+ * producer and the application the only consumer.
+ *
+ * If the queue is full, new events are dropped and counted.
+ *
+ * \param device         A pointer to the device structure of the GPIO port.
+ * \param conf           A pointer to the event queue configuration.
+ *
+ * \retval               0 if the operation is successfull,
+ * \retval               ERROR_CODE if there was an error.
+ */
+int pi_gpio_event_queue_start(struct pi_device *device,
+                              struct pi_gpio_event_queue_conf *conf);
+
+/** \brief Stop recording GPIO notifications.
+ *
+ * Events still in the queue can still be read after this call.
+ *
+ * \param device         A pointer to the device structure of the GPIO port.
+ */
+void pi_gpio_event_queue_stop(struct pi_device *device);
+
+/** \brief Read events from an event queue.
+ *
+ * The events are returned in the order they were recorded and are removed
+ * from the queue. This never blocks.
+ *
+ * \param device         A pointer to the device structure of the GPIO port.
+ * \param events         Array where the events are copied.
+ * \param nb_events      Maximum number of events to copy.
+ *
+ * \return               Number of events copied.
+ */
+uint32_t pi_gpio_event_queue_pop(struct pi_device *device,
+                                 pi_gpio_event_t *events, uint32_t nb_events);
+
+/** \brief Get the number of events dropped by an event queue.
+ *
+ * \param device         A pointer to the device structure of the GPIO port.
+ *
+ * \return               Number of events dropped since the queue was started.
+ */
+uint32_t pi_gpio_event_queue_lost(struct pi_device *device);
+
 //!@}
 
 /**
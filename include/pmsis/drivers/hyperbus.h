@@ -74,7 +74,10 @@ struct pi_hyper_conf
     pi_hyper_type_e type;/*!< Type of device connected on the hyperbus
     interface. */
     uint32_t baudrate;   /*!< Baudrate (in bytes/second). */
-    int32_t burst_length; /*< Maximum burst length in ns. */
+    int32_t burst_length; /*!< Maximum burst length in ns. Copies are
+    automatically split by the driver so that no burst exceeds this length. */
+    uint32_t page_size;  /*!< Size in bytes of the device pages. If it is not
+    zero, copies are also split so that no burst crosses a page boundary. */
 };
 
 /** \brief Hyperbus cluster request structure.
@@ -294,6 +297,134 @@ PI_INLINE_HYPER_LVL_0 void pi_hyper_write_2d_async(struct pi_device *device,
   uint32_t hyper_addr, void *addr, uint32_t size, uint32_t stride,
   uint32_t length, struct pi_task *task);
 
+/** \brief Enqueue a 3D read copy to the Hyperbus (from Hyperbus to
+ * processor).
+ *
+ * The copy is a set of 2D copies (planes), each one being a set of lines as
+ * for pi_hyper_read_2d.
+ * The driver splits the copy into bursts which respect the burst length and
+ * the page size given in the configuration, and keeps as many bursts as
+ * possible enqueued to the hardware to get close to the peak bandwidth.
+ * The caller is blocked until the transfer is finished.
+ * Depending on the chip, there may be some restrictions on the memory which
+ * can be used. Check the chip-specific documentation for more details.
+ *
+ * \param device      The device descriptor of the Hyperbus chip on which to do
+ *   the copy.
+ * \param hyper_addr  The address of the copy in the Hyperbus.
+ * \param addr        The address of the copy in the processor.
+ * \param size        The size in bytes of the copy
+ * \param stride      2D stride, which is the number of bytes which are added
+ *   to the beginning of the current line to switch to the next one.
+ * \param length      2D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next line.
+ * \param stride_3d   3D stride, which is the number of bytes which are added
+ *   to the beginning of the current plane to switch to the next one.
+ * \param length_3d   3D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next plane.
+ */
+PI_INLINE_HYPER_LVL_0 void pi_hyper_read_3d(struct pi_device *device,
+  uint32_t hyper_addr, void *addr, uint32_t size, uint32_t stride,
+  uint32_t length, uint32_t stride_3d, uint32_t length_3d);
+
+/** \brief Enqueue an asynchronous 3D read copy to the Hyperbus (from
+ * Hyperbus to processor).
+ *
+ * The copy is a set of 2D copies (planes), each one being a set of lines as
+ * for pi_hyper_read_2d.
+ * The driver splits the copy into bursts which respect the burst length and
+ * the page size given in the configuration, and keeps as many bursts as
+ * possible enqueued to the hardware to get close to the peak bandwidth.
+ * A task must be specified in order to specify how the caller should be
+ * notified when the whole transfer is finished.
+ * Depending on the chip, there may be some restrictions on the memory which
+ * can be used. Check the chip-specific documentation for more details.
+ *
+ * \param device      The device descriptor of the Hyperbus chip on which to do
+ *   the copy.
+ * \param hyper_addr  The address of the copy in the Hyperbus.
+ * \param addr        The address of the copy in the processor.
+ * \param size        The size in bytes of the copy
+ * \param stride      2D stride, which is the number of bytes which are added
+ *   to the beginning of the current line to switch to the next one.
+ * \param length      2D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next line.
+ * \param stride_3d   3D stride, which is the number of bytes which are added
+ *   to the beginning of the current plane to switch to the next one.
+ * \param length_3d   3D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next plane.
+ * \param task        The task used to notify the end of transfer. See the
+ *   documentation of pi_task_t for more details.
+ */
+PI_INLINE_HYPER_LVL_0 void pi_hyper_read_3d_async(struct pi_device *device,
+  uint32_t hyper_addr, void *addr, uint32_t size, uint32_t stride,
+  uint32_t length, uint32_t stride_3d, uint32_t length_3d,
+  struct pi_task *task);
+
+/** \brief Enqueue a 3D write copy to the Hyperbus (from processor to
+ * Hyperbus).
+ *
+ * The copy is a set of 2D copies (planes), each one being a set of lines as
+ * for pi_hyper_write_2d.
+ * The driver splits the copy into bursts which respect the burst length and
+ * the page size given in the configuration, and keeps as many bursts as
+ * possible enqueued to the hardware to get close to the peak bandwidth.
+ * The caller is blocked until the transfer is finished.
+ * Depending on the chip, there may be some restrictions on the memory which
+ * can be used. Check the chip-specific documentation for more details.
+ *
+ * \param device      The device descriptor of the Hyperbus chip on which to do
+ *   the copy.
+ * \param hyper_addr  The address of the copy in the Hyperbus.
+ * \param addr        The address of the copy in the processor.
+ * \param size        The size in bytes of the copy
+ * \param stride      2D stride, which is the number of bytes which are added
+ *   to the beginning of the current line to switch to the next one.
+ * \param length      2D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next line.
+ * \param stride_3d   3D stride, which is the number of bytes which are added
+ *   to the beginning of the current plane to switch to the next one.
+ * \param length_3d   3D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next plane.
+ */
+PI_INLINE_HYPER_LVL_0 void pi_hyper_write_3d(struct pi_device *device,
+  uint32_t hyper_addr, void *addr, uint32_t size, uint32_t stride,
+  uint32_t length, uint32_t stride_3d, uint32_t length_3d);
+
+/** \brief Enqueue an asynchronous 3D write copy to the Hyperbus (from
+ * processor to Hyperbus).
+ *
+ * The copy is a set of 2D copies (planes), each one being a set of lines as
+ * for pi_hyper_write_2d.
+ * The driver splits the copy into bursts which respect the burst length and
+ * the page size given in the configuration, and keeps as many bursts as
+ * possible enqueued to the hardware to get close to the peak bandwidth.
+ * A task must be specified in order to specify how the caller should be
+ * notified when the whole transfer is finished.
+ * Depending on the chip, there may be some restrictions on the memory which
+ * can be used. Check the chip-specific documentation for more details.
+ *
+ * \param device      The device descriptor of the Hyperbus chip on which to do
+ *   the copy.
+ * \param hyper_addr  The address of the copy in the Hyperbus.
+ * \param addr        The address of the copy in the processor.
+ * \param size        The size in bytes of the copy
+ * \param stride      2D stride, which is the number of bytes which are added
+ *   to the beginning of the current line to switch to the next one.
+ * \param length      2D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next line.
+ * \param stride_3d   3D stride, which is the number of bytes which are added
+ *   to the beginning of the current plane to switch to the next one.
+ * \param length_3d   3D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next plane.
+ * \param task        The task used to notify the end of transfer. See the
+ *   documentation of pi_task_t for more details.
+ */
+PI_INLINE_HYPER_LVL_0 void pi_hyper_write_3d_async(struct pi_device *device,
+  uint32_t hyper_addr, void *addr, uint32_t size, uint32_t stride,
+  uint32_t length, uint32_t stride_3d, uint32_t length_3d,
+  struct pi_task *task);
+
 /** \brief Enqueue a read copy to the Hyperbus from cluster side (from Hyperbus
  * to processor).
  *
@@ -345,6 +476,33 @@ static inline void pi_cl_hyper_read_2d(struct pi_device *device,
   uint32_t hyper_addr, void *addr, uint32_t size, uint32_t stride,
   uint32_t length, pi_cl_hyper_req_t *req);
 
+/** \brief Enqueue a 3D read copy to the Hyperbus from cluster side (from
+ * Hyperbus to processor).
+ *
+ * This is the same as pi_cl_hyper_read_2d, except that the copy is a
+ * sequence of 2D transfers, one for each plane.
+ *
+ * \param device      The device descriptor of the Hyperbus chip on which to do
+ *   the copy.
+ * \param hyper_addr  The address of the copy in the Hyperbus.
+ * \param addr        The address of the copy in the processor.
+ * \param size        The size in bytes of the copy
+ * \param stride      2D stride, which is the number of bytes which are added
+ *   to the beginning of the current line to switch to the next one.
+ * \param length      2D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next line.
+ * \param stride_3d   3D stride, which is the number of bytes which are added
+ *   to the beginning of the current plane to switch to the next one.
+ * \param length_3d   3D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next plane.
+ * \param req         A pointer to the HyperBus request structure. It must be
+ *   allocated by the caller and kept alive until the copy is finished.
+ */
+static inline void pi_cl_hyper_read_3d(struct pi_device *device,
+  uint32_t hyper_addr, void *addr, uint32_t size, uint32_t stride,
+  uint32_t length, uint32_t stride_3d, uint32_t length_3d,
+  pi_cl_hyper_req_t *req);
+
 /** \brief Wait until the specified hyperbus request has finished.
  *
  * This blocks the calling core until the specified cluster remote copy is
@@ -405,6 +563,33 @@ static inline void pi_cl_hyper_write_2d(struct pi_device *device,
   uint32_t hyper_addr, void *addr, uint32_t size, uint32_t stride,
   uint32_t length, pi_cl_hyper_req_t *req);
 
+/** \brief Enqueue a 3D write copy to the Hyperbus from cluster side (from
+ * processor to Hyperbus).
+ *
+ * This is the same as pi_cl_hyper_write_2d, except that the copy is a
+ * sequence of 2D transfers, one for each plane.
+ *
+ * \param device      The device descriptor of the Hyperbus chip on which to do
+ *   the copy.
+ * \param hyper_addr  The address of the copy in the Hyperbus.
+ * \param addr        The address of the copy in the processor.
+ * \param size        The size in bytes of the copy
+ * \param stride      2D stride, which is the number of bytes which are added
+ *   to the beginning of the current line to switch to the next one.
+ * \param length      2D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next line.
+ * \param stride_3d   3D stride, which is the number of bytes which are added
+ *   to the beginning of the current plane to switch to the next one.
+ * \param length_3d   3D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next plane.
+ * \param req         A pointer to the HyperBus request structure. It must be
+ *   allocated by the caller and kept alive until the copy is finished.
+ */
+static inline void pi_cl_hyper_write_3d(struct pi_device *device,
+  uint32_t hyper_addr, void *addr, uint32_t size, uint32_t stride,
+  uint32_t length, uint32_t stride_3d, uint32_t length_3d,
+  pi_cl_hyper_req_t *req);
+
 /** \brief Wait until the specified hyperbus request has finished.
  *
  * This blocks the calling core until the specified cluster remote copy is
@@ -469,6 +654,42 @@ static inline void pi_cl_hyper_copy_2d(struct pi_device *device,
   uint32_t hyper_addr, void *addr, uint32_t size, uint32_t stride,
   uint32_t length, int ext2loc, pi_cl_hyper_req_t *req);
 
+/** \brief Enqueue a 3D copy with the Hyperbus from cluster side.
+ *
+ * This function is a remote call that the cluster can issue to the
+ * fabric-controller in order to ask for an HyperBus copy.
+ * The copy is a set of 2D copies (planes), each one being a set of lines as
+ * for pi_cl_hyper_copy_2d. The whole copy is handled with a single remote
+ * call, the fabric-controller splits it into bursts respecting the burst
+ * length and the page size of the device.
+ * A pointer to a request structure must be provided so that the runtime can
+ * properly do the remote call.
+ * Depending on the chip, there may be some restrictions on the memory which
+ * can be used. Check the chip-specific documentation for more details.
+ *
+ * \param device      The device descriptor of the Hyperbus chip on which to do
+ *   the copy.
+ * \param hyper_addr  The address of the copy in the Hyperbus.
+ * \param addr        The address of the copy in the processor.
+ * \param size        The size in bytes of the copy
+ * \param stride      2D stride, which is the number of bytes which are added
+ *   to the beginning of the current line to switch to the next one.
+ * \param length      2D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next line.
+ * \param stride_3d   3D stride, which is the number of bytes which are added
+ *   to the beginning of the current plane to switch to the next one.
+ * \param length_3d   3D length, which is the number of transferred bytes after
+ *   which the driver will switch to the next plane.
+ * \param ext2loc     1 if the copy is from HyperBus to the chip or 0 for the
+ *   contrary.
+ * \param req         A pointer to the HyperBus request structure. It must be
+ *   allocated by the caller and kept alive until the copy is finished.
+ */
+static inline void pi_cl_hyper_copy_3d(struct pi_device *device,
+  uint32_t hyper_addr, void *addr, uint32_t size, uint32_t stride,
+  uint32_t length, uint32_t stride_3d, uint32_t length_3d, int ext2loc,
+  pi_cl_hyper_req_t *req);
+
 
 //!@}
 
@@ -476,6 +697,159 @@ static inline void pi_cl_hyper_copy_2d(struct pi_device *device,
  * @} end of Hyperbus
  */
 
+/**
+ * @defgroup HyperflashWbuf Hyperflash write buffer
+ * @ingroup Hyperbus
+ *
+ * The Hyperflash write buffer provides support for efficiently appending many
+ * small records to an area of an Hyperflash, typically for logging.
+ *
+ * Records are first copied into a buffer of several pages and the flash is
+ * only programmed when a full page is available. As the other pages of the
+ * buffer can still be filled while a page is being programmed, the caller is
+ * not blocked on each programming operation. In the background, the driver keeps a
+ * configurable number of sectors erased ahead of the write position, so that
+ * a page program never has to wait for a sector erase.
+ *
+ * The area is used as a circular log: once the end of the area is reached,
+ * writing continues from its beginning, erasing the oldest records.
+ */
+
+/**
+ * @addtogroup HyperflashWbuf
+ * @{
+ */
+
+/** \struct pi_hyper_flash_wbuf_conf
+ * \brief Hyperflash write buffer configuration structure.
+ *
+ * This structure is used to pass the desired write buffer configuration to the
+ * runtime when opening it.
+ */
+struct pi_hyper_flash_wbuf_conf
+{
+    void *buffer;          /*!< Buffer used to combine the writes. It must be
+      at least buffer_size bytes and be kept alive until the write buffer is
+      closed. If it is NULL, it is allocated by the driver. */
+    uint32_t buffer_size;  /*!< Size in bytes of the buffer. It must be a
+      multiple of page_size and at least 2 pages, so that records can be
+      appended to one page while another one is being programmed. */
+    uint32_t page_size;    /*!< Size in bytes of a flash page, which is the
+      unit of programming. */
+    uint32_t sector_size;  /*!< Size in bytes of a flash sector, which is the
+      unit of erasing. */
+    uint32_t area_start;   /*!< Hyperflash address of the log area. It must be
+      aligned on sector_size. */
+    uint32_t area_size;    /*!< Size in bytes of the log area. It must be a
+      multiple of sector_size. */
+    uint32_t erase_ahead;  /*!< Number of sectors which are kept erased ahead
+      of the write position. */
+};
+
+/** \struct pi_hyper_flash_wbuf_stats
+ * \brief Hyperflash write buffer statistics.
+ *
+ * The write amplification is the ratio between programmed_bytes and
+ * appended_bytes.
+ */
+struct pi_hyper_flash_wbuf_stats
+{
+    uint64_t appended_bytes;   /*!< Number of bytes appended by the user. */
+    uint64_t programmed_bytes; /*!< Number of bytes programmed in the flash,
+      including page padding due to flushes. */
+    uint32_t page_programs;    /*!< Number of page programs. */
+    uint32_t sector_erases;    /*!< Number of sector erases. */
+    uint32_t erase_stalls;     /*!< Number of times a page program had to wait
+      for a sector erase, which means erase_ahead is too small. */
+};
+
+/** \brief Hyperflash write buffer structure.
+ *
+ * This structure is used by the runtime to manage a write buffer. It must be
+ * instantiated once for each write buffer and must be kept alive until it is
+ * closed.
+ */
+typedef struct pi_hyper_flash_wbuf_s pi_hyper_flash_wbuf_t;
+
+/** \brief Initialize a write buffer configuration with default values.
+ *
+ * \param conf A pointer to the write buffer configuration.
+ */
+void pi_hyper_flash_wbuf_conf_init(struct pi_hyper_flash_wbuf_conf *conf);
+
+/** \brief Open a write buffer.
+ *
+ * This starts the background erase of the first sectors of the area.
+ *
+ * \param device    The device descriptor of the opened Hyperflash.
+ * \param wbuf      A pointer to the write buffer structure.
+ * \param conf      A pointer to the write buffer configuration.
+ * \return          0 if the operation is successfull, -1 if there was an
+ *   error.
+ */
+int pi_hyper_flash_wbuf_open(struct pi_device *device,
+  pi_hyper_flash_wbuf_t *wbuf, struct pi_hyper_flash_wbuf_conf *conf);
+
+/** \brief Close a write buffer.
+ *
+ * Pending data is flushed to the flash before the write buffer is closed.
+ * The caller is blocked until the operation is finished.
+ *
+ * \param wbuf      A pointer to the write buffer structure.
+ */
+void pi_hyper_flash_wbuf_close(pi_hyper_flash_wbuf_t *wbuf);
+
+/** \brief Append a record to a write buffer.
+ *
+ * The data is copied into the write buffer so that the caller can reuse it
+ * as soon as the function returns. The caller is only blocked if all the
+ * pages of the write buffer are full and waiting to be programmed.
+ *
+ * \param wbuf       A pointer to the write buffer structure.
+ * \param data       The address of the record.
+ * \param size       The size in bytes of the record.
+ * \param hyper_addr If not NULL, the Hyperflash address where the record will
+ *   be stored is returned here.
+ * \return           0 if the operation is successfull, -1 if there was an
+ *   error.
+ */
+int pi_hyper_flash_wbuf_append(pi_hyper_flash_wbuf_t *wbuf, const void *data,
+  uint32_t size, uint32_t *hyper_addr);
+
+/** \brief Flush a write buffer.
+ *
+ * This programs the current partial page, padded with the erased value, so
+ * that all the records appended so far are stored in the flash.
+ * The caller is blocked until the operation is finished.
+ *
+ * \param wbuf      A pointer to the write buffer structure.
+ */
+void pi_hyper_flash_wbuf_flush(pi_hyper_flash_wbuf_t *wbuf);
+
+/** \brief Flush asynchronously a write buffer.
+ *
+ * This programs the current partial page, padded with the erased value, so
+ * that all the records appended so far are stored in the flash.
+ *
+ * \param wbuf      A pointer to the write buffer structure.
+ * \param task      The task used to notify the end of the flush.
+ */
+void pi_hyper_flash_wbuf_flush_async(pi_hyper_flash_wbuf_t *wbuf,
+  struct pi_task *task);
+
+/** \brief Get write buffer statistics.
+ *
+ * \param wbuf      A pointer to the write buffer structure.
+ * \param stats     A pointer to the structure where the statistics are
+ *   stored.
+ */
+void pi_hyper_flash_wbuf_stats_get(pi_hyper_flash_wbuf_t *wbuf,
+  struct pi_hyper_flash_wbuf_stats *stats);
+
+/**
+ * @} end of HyperflashWbuf
+ */
+
 
 
 /// @cond IMPLEM
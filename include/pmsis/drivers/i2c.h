@@ -243,6 +243,270 @@ void pi_i2c_read_async(struct pi_device *device, uint8_t *rx_buff, int length,
 void pi_i2c_write_async(struct pi_device *device, uint8_t *tx_data, int length,
   pi_i2c_xfer_flags_e flags, pi_task_t *task);
 
+/** \enum pi_i2c_seg_dir_e
+ * \brief Direction of a segment of an I2C transaction.
+ */
+typedef enum {
+  PI_I2C_SEG_WRITE = 0,  /*!< Segment sending data to the I2C device. */
+  PI_I2C_SEG_READ  = 1   /*!< Segment receiving data from the I2C device. */
+} pi_i2c_seg_dir_e;
+
+/** \struct pi_i2c_seg_t
+ * \brief Segment of an I2C transaction.
+ *
+ * A transaction is made of a list of segments. Each segment is a read or a
+ * write to the device, starting with a START (or repeated START) bit, unless
+ * PI_I2C_XFER_NO_START is set in its flags. In this case, the segment
+ * continues the previous one on the bus, which must have the same direction.
+ * This allows for example sending a register address and the data from two
+ * different buffers in the same write.
+ */
+typedef struct pi_i2c_seg
+{
+  uint8_t *buffer;        /*!< The address in the chip of the data. */
+  uint16_t length;        /*!< The size in bytes of the segment. */
+  pi_i2c_seg_dir_e dir;   /*!< Direction of the segment. */
+  pi_i2c_xfer_flags_e flags; /*!< PI_I2C_XFER_NO_START to continue the
+    previous segment, 0 otherwise. STOP flags are ignored, as the transaction
+    always ends with a single STOP bit. */
+} pi_i2c_seg_t;
+
+/** \brief Execute a transaction made of several segments.
+ *
+ * The segments are executed one after the other, with a repeated START bit
+ * before each of them, unless the segment has the PI_I2C_XFER_NO_START flag,
+ * and a single STOP bit at the end, without giving back
+ * the bus in between. This is typically used for register reads, made of a
+ * write of the register address followed by a read of the value.
+ * The caller is blocked until the whole transaction is finished.
+ * Depending on the chip, there may be some restrictions on the memory which
+ * can be used. Check the chip-specific documentation for more details.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param segs      The array of segments.
+ * \param nb_segs   The number of segments.
+ * \return          0 if the operation is successfull, -1 if the device did
+ *   not acknowledge.
+ */
+int pi_i2c_transfer(struct pi_device *device, pi_i2c_seg_t *segs,
+  int nb_segs);
+
+/** \brief Execute asynchronously a transaction made of several segments.
+ *
+ * This is the same as pi_i2c_transfer, except that the caller is not blocked
+ * and is notified with a single task when the whole transaction is finished.
+ * The segments must be kept alive until then.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param segs      The array of segments.
+ * \param nb_segs   The number of segments.
+ * \param task      The task used to notify the end of the transaction.
+ */
+void pi_i2c_transfer_async(struct pi_device *device, pi_i2c_seg_t *segs,
+  int nb_segs, pi_task_t *task);
+
+/** \brief Get the status of an asynchronous transaction.
+ *
+ * \param task      The task used for notification.
+ * \return          0 if the transaction was successfull, -1 if the device did
+ *   not acknowledge.
+ */
+int pi_i2c_transfer_status(pi_task_t *task);
+
+/** \brief Read consecutive registers of an I2C device.
+ *
+ * This writes the register address and reads the specified number of bytes
+ * with a repeated START, in a single transaction. The device is expected to
+ * auto-increment the register address, so that several consecutive registers
+ * can be read at once.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param reg       The address of the first register.
+ * \param reg_size  The size in bytes of the register address (1 or 2), sent
+ *   MSB first.
+ * \param data      The address in the chip where the values are written.
+ * \param length    The number of bytes to read.
+ * \return          0 if the operation is successfull, -1 if the device did
+ *   not acknowledge.
+ */
+int pi_i2c_reg_read(struct pi_device *device, uint16_t reg, int reg_size,
+  uint8_t *data, int length);
+
+/** \brief Write consecutive registers of an I2C device.
+ *
+ * This writes the register address followed by the values, relying on the
+ * auto-increment of the device. This is done with two write segments, the
+ * second one with PI_I2C_XFER_NO_START, so that the values are sent directly
+ * from the data buffer, without any copy.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param reg       The address of the first register.
+ * \param reg_size  The size in bytes of the register address (1 or 2), sent
+ *   MSB first.
+ * \param data      The address in the chip of the values to be written.
+ * \param length    The number of bytes to write.
+ * \return          0 if the operation is successfull, -1 if the device did
+ *   not acknowledge.
+ */
+int pi_i2c_reg_write(struct pi_device *device, uint16_t reg, int reg_size,
+  uint8_t *data, int length);
+
+/** \brief Read asynchronously consecutive registers of an I2C device.
+ *
+ * This is the same as pi_i2c_reg_read, except that the caller is notified
+ * with the task when the transaction is finished. The status can be retrieved
+ * with pi_i2c_transfer_status.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param reg       The address of the first register.
+ * \param reg_size  The size in bytes of the register address (1 or 2).
+ * \param data      The address in the chip where the values are written.
+ * \param length    The number of bytes to read.
+ * \param task      The task used to notify the end of the transaction.
+ */
+void pi_i2c_reg_read_async(struct pi_device *device, uint16_t reg,
+  int reg_size, uint8_t *data, int length, pi_task_t *task);
+
+/** \brief Write asynchronously consecutive registers of an I2C device.
+ *
+ * This is the same as pi_i2c_reg_write, except that the caller is notified
+ * with the task when the transaction is finished. The status can be retrieved
+ * with pi_i2c_transfer_status.
+ *
+ * \param device    A pointer to the structure describing the device.
+ * \param reg       The address of the first register.
+ * \param reg_size  The size in bytes of the register address (1 or 2).
+ * \param data      The address in the chip of the values to be written.
+ * \param length    The number of bytes to write.
+ * \param task      The task used to notify the end of the transaction.
+ */
+void pi_i2c_reg_write_async(struct pi_device *device, uint16_t reg,
+  int reg_size, uint8_t *data, int length, pi_task_t *task);
+
+/** \brief I2C bus scheduler structure.
+ *
+ * This structure is used by the runtime to manage the transactions of several
+ * logical devices sharing the same I2C interface. It must be kept alive until
+ * the bus is closed.
+ */
+typedef struct pi_i2c_bus_s pi_i2c_bus_t;
+
+/** \brief I2C bus client structure.
+ *
+ * This structure is used by the runtime to manage one logical device on a
+ * bus. It must be kept alive until the client is removed.
+ */
+typedef struct pi_i2c_client_s pi_i2c_client_t;
+
+/** \struct pi_i2c_client_stats
+ * \brief I2C bus client statistics.
+ *
+ * The latency of a transaction is measured from the moment it is enqueued to
+ * the end of the transaction.
+ */
+struct pi_i2c_client_stats
+{
+  uint32_t transactions;   /*!< Number of transactions done. */
+  uint32_t latency_avg_us; /*!< Average latency. */
+  uint32_t latency_max_us; /*!< Maximum latency. */
+};
+
+/** \brief Open an I2C bus scheduler.
+ *
+ * Once opened, the transactions of all the clients of the bus are queued
+ * and executed one after the other. The next transaction is the oldest one
+ * from the clients with the highest priority. To ensure fairness, a pending
+ * transaction is promoted to the next priority level every time it has been
+ * waiting for aging_us micro-seconds.
+ *
+ * The bus scheduler takes exclusive ownership of the interface: this fails if
+ * a device is already opened on this interface with pi_i2c_open, and
+ * pi_i2c_open fails on this interface while the bus is opened. All the
+ * devices of the interface must thus be added as clients.
+ *
+ * \param bus       A pointer to the bus structure.
+ * \param itf       The I2C interface of the bus.
+ * \param aging_us  Waiting time after which a pending transaction is
+ *   promoted. 0 disables aging.
+ * \return          0 if the operation is successfull, -1 if there was an error.
+ */
+int pi_i2c_bus_open(pi_i2c_bus_t *bus, uint8_t itf, uint32_t aging_us);
+
+/** \brief Close an I2C bus scheduler.
+ *
+ * All clients must have been removed before.
+ *
+ * \param bus       A pointer to the bus structure.
+ */
+void pi_i2c_bus_close(pi_i2c_bus_t *bus);
+
+/** \brief Add a logical device to an I2C bus.
+ *
+ * The device is described with the same configuration as for pi_i2c_open,
+ * so that its slave address, maximum baudrate, wait cycles and other settings
+ * are applied to each of its transactions. The interface of the configuration
+ * must be the one of the bus.
+ * The baudrate of the interface is only changed when two consecutive
+ * transactions are for clients with different settings.
+ *
+ * \param bus          A pointer to the bus structure.
+ * \param client       A pointer to the client structure.
+ * \param conf         A pointer to the device configuration, which can be
+ *   released once the function returns.
+ * \param priority     Priority of the transactions of this client, higher
+ *   values are scheduled first.
+ * \return             0 if the operation is successfull, -1 if there was an
+ *   error.
+ */
+int pi_i2c_client_add(pi_i2c_bus_t *bus, pi_i2c_client_t *client,
+  pi_i2c_conf_t *conf, int priority);
+
+/** \brief Remove a logical device from an I2C bus.
+ *
+ * The caller is blocked until all the pending transactions of this client are
+ * finished.
+ *
+ * \param client    A pointer to the client structure.
+ */
+void pi_i2c_client_remove(pi_i2c_client_t *client);
+
+/** \brief Execute a transaction on a logical device.
+ *
+ * This is the same as pi_i2c_transfer, except that the transaction is queued
+ * in the bus scheduler with the priority of the client.
+ * The caller is blocked until the transaction is finished.
+ *
+ * \param client    A pointer to the client structure.
+ * \param segs      The array of segments.
+ * \param nb_segs   The number of segments.
+ * \return          0 if the operation is successfull, -1 if the device did
+ *   not acknowledge.
+ */
+int pi_i2c_client_transfer(pi_i2c_client_t *client, pi_i2c_seg_t *segs,
+  int nb_segs);
+
+/** \brief Execute asynchronously a transaction on a logical device.
+ *
+ * This is the same as pi_i2c_client_transfer, except that the caller is not
+ * blocked. The status can be retrieved with pi_i2c_transfer_status.
+ *
+ * \param client    A pointer to the client structure.
+ * \param segs      The array of segments.
+ * \param nb_segs   The number of segments.
+ * \param task      The task used to notify the end of the transaction.
+ */
+void pi_i2c_client_transfer_async(pi_i2c_client_t *client, pi_i2c_seg_t *segs,
+  int nb_segs, pi_task_t *task);
+
+/** \brief Get the statistics of a logical device.
+ *
+ * \param client    A pointer to the client structure.
+ * \param stats     A pointer to the structure where statistics are stored.
+ * \param reset     If not zero, the statistics are reset after being read.
+ */
+void pi_i2c_client_stats_get(pi_i2c_client_t *client,
+  struct pi_i2c_client_stats *stats, int reset);
+
 //!@}
 
 /**
@@ -635,6 +635,288 @@ int pi_i2s_channel_write_async(struct pi_device *dev, int channel,
  */
 int pi_i2s_write_status(pi_task_t *task);
 
+/**
+ * @brief Callback called for each block received in streaming mode.
+ *
+ * @param arg The argument given when the streaming was started.
+ * @param mem_block Address of the memory block containing received data.
+ *   The block belongs to the application until it is given back with
+ *   pi_i2s_block_release.
+ * @param size Number of bytes received in the block.
+ */
+typedef void (*pi_i2s_block_cb_t)(void *arg, void *mem_block, size_t size);
+
+/**
+ * @brief I2S streaming statistics.
+ */
+struct pi_i2s_stream_stats
+{
+    uint32_t blocks;    /*!< Number of blocks delivered to the callback. */
+    uint32_t overruns;  /*!< Number of blocks dropped because no free block
+        was available in the memory slab when the interface needed one. */
+};
+
+/**
+ * @brief Start streaming reception with a per-block callback.
+ *
+ * This can only be used in memory slab mode. The driver keeps the RX channel
+ * continuously fed with blocks allocated from the memory slab of the
+ * configuration. Each time a block is full, the specified callback is called
+ * from the event kernel with a pointer to the block, without any copy.
+ *
+ * The block then belongs to the application, which must give it back to the
+ * memory slab with pi_i2s_block_release once it has been processed, either
+ * from the callback or later. If the memory slab is empty when the interface
+ * needs a new block, the received samples are dropped and an overrun is
+ * counted, thus the memory slab must contain enough blocks to cover the
+ * processing latency.
+ *
+ * The sampling must then be started with PI_I2S_IOCTL_START. It is stopped
+ * with PI_I2S_IOCTL_STOP as for other modes.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param callback The callback called for each received block.
+ * @param arg The argument given to the callback.
+ *
+ * @retval 0 If successful.
+ * @retval -1 An error occured.
+ */
+int pi_i2s_stream_start(struct pi_device *dev, pi_i2s_block_cb_t callback,
+    void *arg);
+
+/**
+ * @brief Stop streaming reception.
+ *
+ * No callback is called after this function has returned. Blocks which have
+ * already been delivered to the application must still be released with
+ * pi_i2s_block_release.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ */
+void pi_i2s_stream_stop(struct pi_device *dev);
+
+/**
+ * @brief Give back a streamed block to the driver.
+ *
+ * This returns the block to the memory slab of the configuration so that
+ * it can be used again for reception.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param mem_block Address of the memory block, as given to the callback.
+ */
+void pi_i2s_block_release(struct pi_device *dev, void *mem_block);
+
+/**
+ * @brief Get the streaming statistics.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param stats Pointer to the structure where the statistics are stored.
+ * @param reset If not zero, the counters are reset after being read.
+ */
+void pi_i2s_stream_stats_get(struct pi_device *dev,
+    struct pi_i2s_stream_stats *stats, int reset);
+
+/**
+ * @brief Apply a sample conversion before calling the streaming callback.
+ *
+ * When this is set, the driver converts each received block in place before
+ * giving it to the callback registered with pi_i2s_stream_start, using the
+ * same kernel as pi_i2s_deinterleave. This avoids a second pass over the
+ * block in the application.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param out_word_size Word size in bits of the samples given to the callback
+ *   (16 or 32). It must not be bigger than the word size of the interface.
+ * @param planar If not zero, the block is given to the callback in planar
+ *   format, with all the samples of channel 0, then all the samples of
+ *   channel 1 and so on.
+ *
+ * @retval 0 If successful.
+ * @retval -1 The conversion is not supported.
+ */
+int pi_i2s_stream_format_set(struct pi_device *dev, uint8_t out_word_size,
+    int planar);
+
+/**
+ * @brief Callback called for each period in duplex mode.
+ *
+ * @param arg The argument given when the duplex processing was started.
+ * @param rx_block Address of the memory block containing the samples received
+ *   during the period.
+ * @param tx_block Address of the memory block to be filled with the samples
+ *   to be sent.
+ * @param size Size in bytes of both blocks.
+ */
+typedef void (*pi_i2s_duplex_cb_t)(void *arg, void *rx_block, void *tx_block,
+    size_t size);
+
+/**
+ * @brief I2S duplex processing statistics.
+ *
+ * Times are measured from the end of reception of an RX block.
+ */
+struct pi_i2s_duplex_stats
+{
+    uint32_t periods;        /*!< Number of periods processed. */
+    uint32_t late;           /*!< Number of TX blocks which were not ready in
+        time and were replaced by silence. */
+    uint32_t overruns;       /*!< Number of RX blocks dropped. */
+    uint32_t start_min_us;   /*!< Minimum delay before the callback was
+        called. */
+    uint32_t start_max_us;   /*!< Maximum delay before the callback was
+        called. The difference with start_min_us gives the jitter. */
+    uint32_t end_max_us;     /*!< Maximum delay before the callback returned.
+        This must stay below latency_blocks periods. */
+};
+
+/**
+ * @brief Start synchronized RX/TX processing in full duplex mode.
+ *
+ * This can only be used in memory slab mode, when the interface has been
+ * opened with PI_I2S_OPT_FULL_DUPLEX and both RX and TX channels have
+ * been configured with the same block size.
+ *
+ * For each period, the specified callback is called with the block received
+ * during this period and a TX block to be filled. The driver sends this TX
+ * block exactly latency_blocks periods after the end of reception of the RX
+ * block, so that the total latency from input to output is fixed, whatever
+ * the processing jitter. Both blocks are given back to the memory slab when
+ * they are not needed anymore, the application must not release them.
+ *
+ * If the callback has not returned in time, silence is sent instead and a
+ * late period is counted.
+ *
+ * The sampling must then be started with PI_I2S_IOCTL_START.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param latency_blocks Number of periods between the end of reception of an
+ *   RX block and the start of emission of the corresponding TX block. It must
+ *   be at least 1, and the memory slab must contain at least
+ *   2 * (latency_blocks + 1) blocks.
+ * @param callback The callback called for each period.
+ * @param arg The argument given to the callback.
+ *
+ * @retval 0 If successful.
+ * @retval -1 An error occured.
+ */
+int pi_i2s_duplex_start(struct pi_device *dev, int latency_blocks,
+    pi_i2s_duplex_cb_t callback, void *arg);
+
+/**
+ * @brief Stop synchronized RX/TX processing.
+ *
+ * No callback is called after this function has returned.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ */
+void pi_i2s_duplex_stop(struct pi_device *dev);
+
+/**
+ * @brief Get the duplex processing statistics.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param stats Pointer to the structure where the statistics are stored.
+ * @param reset If not zero, the counters are reset after being read.
+ */
+void pi_i2s_duplex_stats_get(struct pi_device *dev,
+    struct pi_i2s_duplex_stats *stats, int reset);
+
+/**
+ * @brief Deinterleave frames into planar per-channel buffers.
+ *
+ * The input buffer contains nb_frames frames of nb_channels words, as
+ * received on the interface in TDM or multi-channel mode. Each word is
+ * converted from in_word_size to out_word_size and stored in the buffer
+ * of its channel.
+ *
+ * 24-bit words are stored in 32-bit containers. When reducing the word size,
+ * the most significant bits are kept. When increasing it, the word is sign
+ * extended or not, depending on ch_format.
+ *
+ * The conversion can be done in place by giving out[0] equal to in, if
+ * out_word_size is not bigger than in_word_size. In this case, out[i] must be
+ * out[0] + i * nb_frames * S, where S is the output container size in bytes,
+ * i.e. 2 for 16-bit words and 4 for 24-bit and 32-bit words.
+ *
+ * Contrary to other functions, this one can be called from both
+ * fabric-controller and cluster side, for example from a streaming callback.
+ *
+ * @param in Input buffer containing interleaved frames.
+ * @param out Array of nb_channels pointers to the output buffers.
+ * @param nb_channels Number of channels per frame.
+ * @param nb_frames Number of frames to convert.
+ * @param in_word_size Input word size in bits (16, 24 or 32).
+ * @param out_word_size Output word size in bits (16, 24 or 32).
+ * @param ch_format Channel format giving the sign extension, as a
+ *   PI_I2S_CH_FMT_DATA_SIGN_* constant.
+ */
+void pi_i2s_deinterleave(const void *in, void **out, int nb_channels,
+    uint32_t nb_frames, uint8_t in_word_size, uint8_t out_word_size,
+    uint8_t ch_format);
+
+/**
+ * @brief Interleave planar per-channel buffers into frames.
+ *
+ * This is the opposite of pi_i2s_deinterleave and is typically used to
+ * prepare a TX block for TDM or multi-channel mode.
+ *
+ * Contrary to other functions, this one can be called from both
+ * fabric-controller and cluster side.
+ *
+ * @param in Array of nb_channels pointers to the input buffers.
+ * @param out Output buffer receiving interleaved frames.
+ * @param nb_channels Number of channels per frame.
+ * @param nb_frames Number of frames to convert.
+ * @param in_word_size Input word size in bits (16, 24 or 32).
+ * @param out_word_size Output word size in bits (16, 24 or 32).
+ * @param ch_format Channel format giving the sign extension, as a
+ *   PI_I2S_CH_FMT_DATA_SIGN_* constant.
+ */
+void pi_i2s_interleave(void **in, void *out, int nb_channels,
+    uint32_t nb_frames, uint8_t in_word_size, uint8_t out_word_size,
+    uint8_t ch_format);
+
+/**
+ * @brief Convert the word size of a buffer of samples.
+ *
+ * The conversion can be done in place if out is equal to in and
+ * out_word_size is not bigger than in_word_size.
+ *
+ * Contrary to other functions, this one can be called from both
+ * fabric-controller and cluster side.
+ *
+ * @param in Input buffer.
+ * @param out Output buffer.
+ * @param nb_samples Number of samples to convert.
+ * @param in_word_size Input word size in bits (16, 24 or 32).
+ * @param out_word_size Output word size in bits (16, 24 or 32).
+ * @param ch_format Channel format giving the sign extension, as a
+ *   PI_I2S_CH_FMT_DATA_SIGN_* constant.
+ */
+void pi_i2s_word_convert(const void *in, void *out, uint32_t nb_samples,
+    uint8_t in_word_size, uint8_t out_word_size, uint8_t ch_format);
+
+/**
+ * @brief Deinterleave frames into planar buffers on the cluster cores.
+ *
+ * This is the same as pi_i2s_deinterleave, except that the frames are
+ * distributed over the cores of the current team. It must be called by all
+ * the cores of the team, from an entry point forked with pi_cl_team_fork,
+ * and includes a final barrier. In-place conversion is not supported.
+ *
+ * @param in Input buffer containing interleaved frames.
+ * @param out Array of nb_channels pointers to the output buffers.
+ * @param nb_channels Number of channels per frame.
+ * @param nb_frames Number of frames to convert.
+ * @param in_word_size Input word size in bits (16, 24 or 32).
+ * @param out_word_size Output word size in bits (16, 24 or 32).
+ * @param ch_format Channel format giving the sign extension, as a
+ *   PI_I2S_CH_FMT_DATA_SIGN_* constant.
+ */
+void pi_cl_i2s_deinterleave(const void *in, void **out, int nb_channels,
+    uint32_t nb_frames, uint8_t in_word_size, uint8_t out_word_size,
+    uint8_t ch_format);
+
 /**
  * @}
  */
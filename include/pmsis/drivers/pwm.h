@@ -104,7 +104,8 @@ typedef enum
     PI_PWM_CHANNEL0 = 0x00,  /*!< PWM module channel 0. */
     PI_PWM_CHANNEL1 = 0x01,  /*!< PWM module channel 1. */
     PI_PWM_CHANNEL2 = 0x02,  /*!< PWM module channel 2. */
-    PI_PWM_CHANNEL3 = 0x03   /*!< PWM module channel 3. */
+    PI_PWM_CHANNEL3 = 0x03,  /*!< PWM module channel 3. */
+    PI_PWM_CHANNEL_NB        /*!< Number of channels of a PWM module. */
 } pi_pwm_channel_e;
 
 /**
@@ -316,6 +317,98 @@ static inline void pi_pwm_timer_stop(struct pi_device *device);
 int32_t pi_pwm_duty_cycle_set(struct pi_device *device,
                               uint32_t frequency, uint8_t duty_cycle);
 
+/**
+ * \struct pi_pwm_seq_step
+ * \brief PWM sequencer step.
+ *
+ * This structure describes the values applied to the timer and its channels
+ * for one step of a sequence. All the values of a step are applied at the
+ * same time, at the end of a timer period.
+ */
+struct pi_pwm_seq_step
+{
+    uint16_t period;          /*!< Counter end of the timer, in timer ticks.
+                                0 keeps the current value. */
+    uint16_t ch_threshold[PI_PWM_CHANNEL_NB]; /*!< Threshold of each
+                                channel, in timer ticks. Only the channels of
+                                the sequence mask are updated. */
+};
+
+/**
+ * \struct pi_pwm_seq_conf
+ * \brief PWM sequencer configuration structure.
+ */
+struct pi_pwm_seq_conf
+{
+    struct pi_pwm_seq_step *steps; /*!< Array of steps. It must be kept alive
+                                     until the sequence is finished. */
+    uint32_t nb_steps;             /*!< Number of steps. */
+    uint16_t periods_per_step;     /*!< Number of timer periods during which
+                                     each step is applied. */
+    uint8_t ch_mask;               /*!< Mask of the channels updated by the
+                                     sequence, bit i for PI_PWM_CHANNELi. */
+    uint32_t repeat;               /*!< Number of times the sequence is played,
+                                     0 to play it until it is stopped. */
+};
+
+/**
+ * \brief Initialize a PWM sequencer configuration structure.
+ *
+ * \param conf           PWM sequencer configuration structure.
+ */
+void pi_pwm_seq_conf_init(struct pi_pwm_seq_conf *conf);
+
+/**
+ * \brief Start a PWM sequence.
+ *
+ * This plays autonomously a sequence of period and duty-cycle values on the
+ * timer of the device. The values are loaded at the end of each timer period,
+ * by the uDMA when the chip supports it or from the timer interrupt
+ * otherwise, so that the channels of the timer are always updated together
+ * and without CPU intervention for each period.
+ *
+ * The timer must have been configured and started before.
+ * The caller is blocked until the sequence is finished, so repeat must not be
+ * 0.
+ *
+ * \param device         Device structure.
+ * \param conf           PWM sequencer configuration structure.
+ *
+ * \retval 0             If operation is successful.
+ * \retval ERR_CODE      Otherwise.
+ */
+int32_t pi_pwm_seq_start(struct pi_device *device,
+                         struct pi_pwm_seq_conf *conf);
+
+/**
+ * \brief Start a PWM sequence asynchronously.
+ *
+ * This is the same as pi_pwm_seq_start, except that the caller is not
+ * blocked. The task is pushed when the sequence is finished or when it is
+ * stopped with pi_pwm_seq_stop.
+ *
+ * \param device         Device structure.
+ * \param conf           PWM sequencer configuration structure. It must be
+ *                       kept alive until the sequence is finished.
+ * \param task           Event task used to notify the end of the sequence.
+ *
+ * \retval 0             If operation is successful.
+ * \retval ERR_CODE      Otherwise.
+ */
+int32_t pi_pwm_seq_start_async(struct pi_device *device,
+                               struct pi_pwm_seq_conf *conf, pi_task_t *task);
+
+/**
+ * \brief Stop a PWM sequence.
+ *
+ * The sequence is stopped at the end of the current step. The timer keeps
+ * running with the values of this step and the task of
+ * pi_pwm_seq_start_async is pushed.
+ *
+ * \param device         Device structure.
+ */
+void pi_pwm_seq_stop(struct pi_device *device);
+
 /**
  * @} end of PWM
  */
@@ -221,6 +221,107 @@ uint32_t pi_rtc_timer_get(struct pi_device *device);
  */
 int pi_rtc_ioctl(struct pi_device *device, uint32_t cmd, void *arg);
 
+/**
+ * \brief RTC scheduler job structure.
+ *
+ * This structure is used by the runtime to manage a job of the RTC scheduler.
+ * It must be kept alive until the job is removed or, for a one-shot job,
+ * until it has been executed.
+ */
+typedef struct pi_rtc_job_s pi_rtc_job_t;
+
+/**
+ * \struct pi_rtc_sched_stats
+ * \brief RTC scheduler statistics.
+ *
+ * The number of wakeups saved by batching is jobs_run - wakeups.
+ */
+struct pi_rtc_sched_stats
+{
+    uint32_t elapsed_s; /*!< Time since the scheduler was started, in
+                          seconds. */
+    uint32_t wakeups;   /*!< Number of RTC wakeups. */
+    uint32_t jobs_run;  /*!< Number of job executions. */
+};
+
+/**
+ * \brief Start the RTC scheduler.
+ *
+ * The scheduler uses the countdown timer of the RTC device to execute many
+ * periodic or one-shot jobs. It always programs the countdown for the
+ * nearest deadline, and on each wakeup, it also executes all the jobs whose
+ * tolerance window includes the current time, so that jobs with close
+ * deadlines are batched into a single wakeup and the chip can stay longer in
+ * low-power mode.
+ *
+ * The countdown timer must not be used directly while the scheduler is
+ * started.
+ *
+ * \param device         Device structure.
+ *
+ * \retval 0             If operation is successful.
+ * \retval ERRNO         An error code otherwise.
+ */
+int pi_rtc_sched_start(struct pi_device *device);
+
+/**
+ * \brief Stop the RTC scheduler.
+ *
+ * All the jobs are removed.
+ *
+ * \param device         Device structure.
+ */
+void pi_rtc_sched_stop(struct pi_device *device);
+
+/**
+ * \brief Add a job to the RTC scheduler.
+ *
+ * The callback is executed for the first time after the specified delay and
+ * then, if the period is not 0, every period. It may be executed up to
+ * tolerance_ms milliseconds before its deadline, if this allows sharing a
+ * wakeup with another job, but is never executed after it.
+ *
+ * The deadlines of a periodic job always advance from the nominal deadline,
+ * not from the time the job was actually executed, so that early executions
+ * do not make the job drift.
+ *
+ * The callback is executed from the event kernel, not from the interrupt
+ * handler, so it can call other driver functions, but must not block.
+ *
+ * \param device         Device structure.
+ * \param job            Job structure.
+ * \param delay_ms       Delay before the first execution, in milliseconds.
+ * \param period_ms      Period of the job in milliseconds, 0 for a one-shot
+ *                       job.
+ * \param tolerance_ms   How much in advance the job can be executed, in
+ *                       milliseconds.
+ * \param callback       Function executed by the job.
+ * \param arg            Argument given to the function.
+ *
+ * \retval 0             If operation is successful.
+ * \retval ERRNO         An error code otherwise.
+ */
+int pi_rtc_job_add(struct pi_device *device, pi_rtc_job_t *job,
+                   uint32_t delay_ms, uint32_t period_ms,
+                   uint32_t tolerance_ms, callback_t callback, void *arg);
+
+/**
+ * \brief Remove a job from the RTC scheduler.
+ *
+ * \param device         Device structure.
+ * \param job            Job structure.
+ */
+void pi_rtc_job_remove(struct pi_device *device, pi_rtc_job_t *job);
+
+/**
+ * \brief Get the RTC scheduler statistics.
+ *
+ * \param device         Device structure.
+ * \param stats          Structure where the statistics are stored.
+ */
+void pi_rtc_sched_stats_get(struct pi_device *device,
+                            struct pi_rtc_sched_stats *stats);
+
 /**
  * @} end of RTC
  */
@@ -443,6 +443,354 @@ int pi_cl_uart_read_byte(pi_device_t *device, uint8_t *byte, pi_cl_uart_req_t *r
  */
 static inline void pi_cl_uart_read_wait(pi_cl_uart_req_t *req);
 
+/**
+ * \enum pi_uart_rx_event
+ *
+ * \brief Events notified by the RX ring.
+ */
+enum pi_uart_rx_event
+{
+    PI_UART_RX_EVENT_IDLE       = 0, /*!< The line has been idle for the
+                                       configured timeout after some bytes
+                                       were received. */
+    PI_UART_RX_EVENT_HIGH_WATER = 1, /*!< The number of bytes available in the
+                                       ring reached the high-water mark. */
+    PI_UART_RX_EVENT_OVERFLOW   = 2  /*!< The ring was full and bytes were
+                                       lost. */
+};
+
+/**
+ * \brief Callback called on RX ring events.
+ *
+ * \param arg            Argument given in the RX ring configuration.
+ * \param event          Event which triggered the call.
+ * \param available      Number of bytes available in the ring.
+ */
+typedef void (*pi_uart_rx_cb_t)(void *arg, enum pi_uart_rx_event event,
+                                uint32_t available);
+
+/**
+ * \struct pi_uart_rx_ring_conf
+ *
+ * \brief UART RX ring configuration structure.
+ */
+struct pi_uart_rx_ring_conf
+{
+    void *buffer;              /*!< Ring buffer. It must be kept alive until
+                                 the ring is stopped. */
+    uint32_t size;             /*!< Size in bytes of the ring buffer. */
+    uint32_t idle_timeout_us;  /*!< Idle time after which received bytes are
+                                 notified. 0 disables idle notifications. */
+    uint32_t high_water;       /*!< Number of available bytes after which they
+                                 are notified. 0 disables this notification. */
+    pi_uart_rx_cb_t callback;  /*!< Callback called on events. */
+    void *arg;                 /*!< Argument given to the callback. */
+};
+
+/**
+ * \struct pi_uart_rx_ring_stats
+ *
+ * \brief UART RX ring statistics.
+ */
+struct pi_uart_rx_ring_stats
+{
+    uint32_t received;  /*!< Number of bytes received. */
+    uint32_t lost;      /*!< Number of bytes lost because the ring was full. */
+};
+
+/**
+ * \brief Initialize an RX ring configuration with default values.
+ *
+ * \param conf           Pointer to the RX ring configuration.
+ */
+void pi_uart_rx_ring_conf_init(struct pi_uart_rx_ring_conf *conf);
+
+/**
+ * \brief Start continuous reception into a ring buffer.
+ *
+ * Once started, reception is continuously armed and all received bytes are
+ * stored in the ring buffer, without the need to know the size of incoming
+ * messages. The application is notified through the callback when the line
+ * becomes idle after some bytes were received, when the high-water mark is
+ * reached, or when bytes are lost, and can then get the received bytes with
+ * pi_uart_rx_ring_read or pi_uart_rx_ring_peek.
+ *
+ * The usual read functions must not be used while the ring is started.
+ *
+ * \param device         Pointer to device descriptor of the UART device.
+ * \param conf           Pointer to the RX ring configuration.
+ *
+ * \retval 0             If operation is successfull.
+ * \retval ERRNO         An error code otherwise.
+ */
+int pi_uart_rx_ring_start(struct pi_device *device,
+                          struct pi_uart_rx_ring_conf *conf);
+
+/**
+ * \brief Stop continuous reception into a ring buffer.
+ *
+ * Bytes still in the ring are discarded.
+ *
+ * \param device         Pointer to device descriptor of the UART device.
+ */
+void pi_uart_rx_ring_stop(struct pi_device *device);
+
+/**
+ * \brief Copy received bytes out of the ring.
+ *
+ * This never blocks.
+ *
+ * \param device         Pointer to device descriptor of the UART device.
+ * \param buffer         Pointer to data buffer.
+ * \param size           Maximum number of bytes to copy.
+ *
+ * \return               Number of bytes copied.
+ */
+uint32_t pi_uart_rx_ring_read(struct pi_device *device, void *buffer,
+                              uint32_t size);
+
+/**
+ * \brief Get received bytes without copy.
+ *
+ * This gives the largest contiguous area of received bytes in the ring. The
+ * bytes stay in the ring until pi_uart_rx_ring_consume is called.
+ *
+ * \param device         Pointer to device descriptor of the UART device.
+ * \param data           Pointer to the variable storing the address of the
+ *                       first received byte.
+ *
+ * \return               Number of contiguous bytes available at this address.
+ */
+uint32_t pi_uart_rx_ring_peek(struct pi_device *device, void **data);
+
+/**
+ * \brief Release bytes from the ring.
+ *
+ * \param device         Pointer to device descriptor of the UART device.
+ * \param size           Number of bytes to release, at most the value returned
+ *                       by pi_uart_rx_ring_peek.
+ */
+void pi_uart_rx_ring_consume(struct pi_device *device, uint32_t size);
+
+/**
+ * \brief Get the RX ring statistics.
+ *
+ * \param device         Pointer to device descriptor of the UART device.
+ * \param stats          Pointer to the structure where statistics are stored.
+ */
+void pi_uart_rx_ring_stats_get(struct pi_device *device,
+                               struct pi_uart_rx_ring_stats *stats);
+
+/**
+ * \enum pi_uart_tx_policy
+ *
+ * \brief Behavior of the TX queue when it is full.
+ */
+enum pi_uart_tx_policy
+{
+    PI_UART_TX_POLICY_BLOCK       = 0, /*!< The caller is blocked until there
+                                         is enough space. */
+    PI_UART_TX_POLICY_DROP_OLDEST = 1, /*!< The oldest queued bytes not yet
+                                         being sent are dropped. */
+    PI_UART_TX_POLICY_DROP_NEWEST = 2  /*!< The new write is dropped. */
+};
+
+/**
+ * \struct pi_uart_tx_queue_conf
+ *
+ * \brief UART TX queue configuration structure.
+ */
+struct pi_uart_tx_queue_conf
+{
+    void *buffer;                  /*!< Staging ring buffer. It must be kept
+                                     alive until the queue is stopped. */
+    uint32_t size;                 /*!< Size in bytes of the staging buffer. */
+    uint32_t max_transfer;         /*!< Maximum size in bytes of one transfer.
+                                     0 means no limit. */
+    enum pi_uart_tx_policy policy; /*!< Behavior when the queue is full. */
+};
+
+/**
+ * \struct pi_uart_tx_queue_stats
+ *
+ * \brief UART TX queue statistics.
+ */
+struct pi_uart_tx_queue_stats
+{
+    uint32_t writes;     /*!< Number of writes queued. */
+    uint32_t bytes;      /*!< Number of bytes sent. */
+    uint32_t transfers;  /*!< Number of transfers issued. */
+    uint32_t dropped;    /*!< Number of bytes dropped. */
+    uint32_t blocked;    /*!< Number of writes which had to wait. */
+};
+
+/**
+ * \brief Initialize a TX queue configuration with default values.
+ *
+ * \param conf           Pointer to the TX queue configuration.
+ */
+void pi_uart_tx_queue_conf_init(struct pi_uart_tx_queue_conf *conf);
+
+/**
+ * \brief Start coalescing writes into a TX queue.
+ *
+ * Once started, writes done with pi_uart_tx_queue_write are copied into the
+ * staging buffer and sent with as few transfers as possible: as long as a
+ * transfer is on-going, new writes are accumulated and sent together with the
+ * next transfer.
+ *
+ * \param device         Pointer to device descriptor of the UART device.
+ * \param conf           Pointer to the TX queue configuration.
+ *
+ * \retval 0             If operation is successfull.
+ * \retval ERRNO         An error code otherwise.
+ */
+int pi_uart_tx_queue_start(struct pi_device *device,
+                           struct pi_uart_tx_queue_conf *conf);
+
+/**
+ * \brief Stop a TX queue.
+ *
+ * The caller is blocked until all queued bytes are sent.
+ *
+ * \param device         Pointer to device descriptor of the UART device.
+ */
+void pi_uart_tx_queue_stop(struct pi_device *device);
+
+/**
+ * \brief Queue data for transmission.
+ *
+ * The data is copied so that the buffer can be reused as soon as the function
+ * returns. If the queue is full, the configured policy is applied.
+ *
+ * With PI_UART_TX_POLICY_BLOCK, a write bigger than the staging buffer is
+ * split into chunks which are queued one after the other as space is freed,
+ * and the caller is blocked until the last chunk is queued. As the caller can
+ * be blocked, this policy must not be used from an event callback or from an
+ * interrupt handler. With the drop policies, a write bigger than the staging
+ * buffer is rejected and counted in the dropped bytes.
+ *
+ * \param device         Pointer to device descriptor of the UART device.
+ * \param buffer         Pointer to data buffer.
+ * \param size           Size of data to copy in bytes.
+ *
+ * \return               Number of bytes queued.
+ */
+uint32_t pi_uart_tx_queue_write(struct pi_device *device, const void *buffer,
+                                uint32_t size);
+
+/**
+ * \brief Wait until all queued bytes are sent.
+ *
+ * \param device         Pointer to device descriptor of the UART device.
+ */
+void pi_uart_tx_queue_flush(struct pi_device *device);
+
+/**
+ * \brief Get the TX queue statistics.
+ *
+ * \param device         Pointer to device descriptor of the UART device.
+ * \param stats          Pointer to the structure where statistics are stored.
+ */
+void pi_uart_tx_queue_stats_get(struct pi_device *device,
+                                struct pi_uart_tx_queue_stats *stats);
+
+/**
+ * \brief UART cluster staging buffer structure.
+ *
+ * This structure is used by the runtime to manage a staging buffer where
+ * cluster cores can write data to be sent on the UART. It must be kept alive
+ * until the staging buffer is closed and must be allocated in a memory
+ * accessible by the cluster.
+ */
+typedef struct pi_cl_uart_staging_s pi_cl_uart_staging_t;
+
+/**
+ * \struct pi_cl_uart_staging_stats
+ *
+ * \brief UART cluster staging buffer statistics.
+ */
+struct pi_cl_uart_staging_stats
+{
+    uint32_t writes;   /*!< Number of writes done by cluster cores. */
+    uint32_t flushes;  /*!< Number of batches sent by the FC. */
+    uint32_t dropped;  /*!< Number of bytes dropped because the buffer was
+                         full. */
+};
+
+/**
+ * \brief Open a cluster staging buffer on an UART.
+ *
+ * This is called from FC side to prepare a buffer where cluster cores can
+ * write data with pi_cl_uart_staging_write, without any remote call to the FC
+ * for each write. The FC sends the content of the buffer in batches,
+ * either when a cluster core calls pi_cl_uart_staging_flush, when the buffer
+ * is half full, or periodically.
+ *
+ * \param device         Pointer to device descriptor of the UART device.
+ * \param staging        Pointer to the staging buffer structure.
+ * \param buffer         Buffer used to store the data, preferably in cluster
+ *                       memory. It must be kept alive until the staging buffer
+ *                       is closed.
+ * \param size           Size in bytes of the buffer.
+ * \param period_us      Period in micro-seconds of the flush done by the FC.
+ *                       0 disables periodic flushes.
+ *
+ * \retval 0             If operation is successfull.
+ * \retval ERRNO         An error code otherwise.
+ */
+int pi_cl_uart_staging_open(struct pi_device *device,
+                            pi_cl_uart_staging_t *staging, void *buffer,
+                            uint32_t size, uint32_t period_us);
+
+/**
+ * \brief Close a cluster staging buffer.
+ *
+ * This is called from FC side, once no cluster core is using the staging
+ * buffer anymore. The remaining data is sent before the function returns.
+ *
+ * \param staging        Pointer to the staging buffer structure.
+ */
+void pi_cl_uart_staging_close(pi_cl_uart_staging_t *staging);
+
+/**
+ * \brief Get the cluster staging buffer statistics.
+ *
+ * \param staging        Pointer to the staging buffer structure.
+ * \param stats          Pointer to the structure where statistics are stored.
+ */
+void pi_cl_uart_staging_stats_get(pi_cl_uart_staging_t *staging,
+                                  struct pi_cl_uart_staging_stats *stats);
+
+/**
+ * \brief Write data to a cluster staging buffer.
+ *
+ * This is called from cluster side and can be called concurrently by all
+ * the cores of the cluster. Space is reserved in the buffer with an atomic
+ * operation and the data is copied, so that writes from different cores are
+ * never mixed together. The FC is not involved and the caller is never
+ * blocked. If there is not enough space, the write is dropped.
+ *
+ * \param staging        Pointer to the staging buffer structure.
+ * \param buffer         Pointer to data buffer.
+ * \param size           Size of data to copy in bytes.
+ *
+ * \return               Number of bytes written, either size or 0.
+ */
+static inline uint32_t pi_cl_uart_staging_write(pi_cl_uart_staging_t *staging,
+                                                const void *buffer,
+                                                uint32_t size);
+
+/**
+ * \brief Ask the FC to send the content of a cluster staging buffer.
+ *
+ * This is called from cluster side and only notifies the FC, the caller is
+ * not blocked until the data is sent.
+ *
+ * \param staging        Pointer to the staging buffer structure.
+ */
+static inline void pi_cl_uart_staging_flush(pi_cl_uart_staging_t *staging);
+
 /**
  * @}
  */
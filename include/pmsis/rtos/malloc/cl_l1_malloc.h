@@ -113,6 +113,175 @@ malloc_t pi_cl_l1_malloc_struct_get(void);
  * @} CL_L1_Malloc
  */
 
+/**
+ * @defgroup CL_L1_Arena CL_L1 Arena allocation
+ *
+ * \brief Scoped arena allocation in Cluster L1 memory.
+ *
+ * This follows the same conventions as the CL_Arena allocator, for an arena
+ * reserved in cluster L1. Chunks are allocated in constant time by bumping an
+ * offset, and can be released by scopes: a frame is pushed before allocating
+ * the buffers of a processing step, and popping it releases all of them at
+ * once.
+ *
+ * As consecutive buffers of the same size often start on the same TCDM bank,
+ * buffers accessed concurrently by all cores can also be allocated on a
+ * chosen bank, so that their accesses are spread across banks.
+ *
+ * While an arena is initialized, its memory is reserved in L1, so automatic
+ * power management of the cluster does not power it down.
+ *
+ * @addtogroup CL_L1_Arena
+ * @{
+ */
+
+/**
+ * \brief Cluster L1 arena structure.
+ *
+ * This structure is used by the runtime to manage an L1 arena.
+ * It must be instantiated once for each arena and must be kept alive until
+ * the arena is deinitialized. As it is accessed by the cluster cores, it
+ * should be instantiated in a memory visible from the cluster, for example as
+ * a global variable.
+ */
+typedef struct pi_cl_l1_arena_s pi_cl_l1_arena_t;
+
+/**
+ * \brief Reserve an arena in Cluster L1 memory.
+ *
+ * This can be called only when the specified cluster is opened.
+ *
+ * \param arena          Arena structure to initialize.
+ * \param device         Cluster device where to allocate memory.
+ * \param size           Size in bytes of the arena.
+ *
+ * \retval 0             If operation is successful.
+ * \retval -1            If there was not enough memory available.
+ */
+int pi_cl_l1_arena_init(pi_cl_l1_arena_t *arena, struct pi_device *device,
+                        uint32_t size);
+
+/**
+ * \brief Release the memory reserved for an arena.
+ *
+ * This gives back to the L1 allocator the memory reserved when the arena was
+ * initialized. It must be called when no cluster task is using the arena
+ * anymore.
+ *
+ * \param arena          Arena structure.
+ */
+void pi_cl_l1_arena_deinit(pi_cl_l1_arena_t *arena);
+
+/**
+ * \brief Allocate memory from an arena.
+ *
+ * The allocated memory is 4-bytes aligned.
+ * Contrary to pi_cl_arena_alloc, this is not safe against concurrent calls on
+ * the same arena, allocations are typically done by the cluster controller
+ * before forking.
+ *
+ * \param arena          Arena structure.
+ * \param size           Size in bytes of the memory to be allocated.
+ * \param chunk          Pointer to the variable where the address of the
+ *                       allocated chunk is stored.
+ *
+ * \retval 0             If operation is successful.
+ * \retval -1            If there is not enough memory left in the arena.
+ */
+static inline int pi_cl_l1_arena_alloc(pi_cl_l1_arena_t *arena, uint32_t size,
+                                       uint32_t *chunk);
+
+/**
+ * \brief Allocate memory from an arena, starting on a given bank.
+ *
+ * This is the same as pi_cl_l1_arena_alloc, except that the chunk is padded
+ * so that its first word is on the specified TCDM bank. Giving a different
+ * bank to each buffer accessed concurrently by the cores avoids bank
+ * conflicts when all cores access them with the same index.
+ *
+ * \param arena          Arena structure.
+ * \param size           Size in bytes of the memory to be allocated.
+ * \param bank           TCDM bank of the first word of the chunk. It is
+ *                       taken modulo the number of banks returned by
+ *                       pi_cl_l1_arena_nb_banks.
+ * \param chunk          Pointer to the variable where the address of the
+ *                       allocated chunk is stored.
+ *
+ * \retval 0             If operation is successful.
+ * \retval -1            If there is not enough memory left in the arena.
+ */
+static inline int pi_cl_l1_arena_alloc_bank(pi_cl_l1_arena_t *arena,
+                                            uint32_t size, uint32_t bank,
+                                            uint32_t *chunk);
+
+/**
+ * \brief Return the number of TCDM banks of the arena memory.
+ *
+ * This can be used to give a distinct bank to each of the buffers allocated
+ * with pi_cl_l1_arena_alloc_bank.
+ *
+ * \param arena          Arena structure.
+ *
+ * \return               The number of banks.
+ */
+static inline uint32_t pi_cl_l1_arena_nb_banks(pi_cl_l1_arena_t *arena);
+
+/**
+ * \brief Open an allocation frame.
+ *
+ * \param arena          Arena structure.
+ *
+ * \return               A marker identifying the frame, to be given to
+ *                       pi_cl_l1_arena_pop.
+ */
+static inline uint32_t pi_cl_l1_arena_push(pi_cl_l1_arena_t *arena);
+
+/**
+ * \brief Close an allocation frame.
+ *
+ * This releases at once all the chunks allocated since the frame was opened,
+ * including the ones of nested frames.
+ *
+ * \param arena          Arena structure.
+ * \param frame          Marker returned by pi_cl_l1_arena_push.
+ */
+static inline void pi_cl_l1_arena_pop(pi_cl_l1_arena_t *arena, uint32_t frame);
+
+/**
+ * \brief Release all the chunks allocated from an arena.
+ *
+ * This is the same as popping all the frames of the arena.
+ *
+ * \param arena          Arena structure.
+ */
+static inline void pi_cl_l1_arena_reset(pi_cl_l1_arena_t *arena);
+
+/**
+ * \brief Return the number of bytes allocated from an arena.
+ *
+ * \param arena          Arena structure.
+ *
+ * \return               Size in bytes currently allocated, including the
+ *                       bank padding.
+ */
+static inline uint32_t pi_cl_l1_arena_used(pi_cl_l1_arena_t *arena);
+
+/**
+ * \brief Return the maximum number of bytes ever allocated from an arena.
+ *
+ * This includes the bank padding and can be used to tune the size of the
+ * arena.
+ *
+ * \param arena          Arena structure.
+ *
+ * \return               Size in bytes.
+ */
+static inline uint32_t pi_cl_l1_arena_high_water(pi_cl_l1_arena_t *arena);
+
+/**
+ * @} CL_L1_Arena
+ */
+
 /**
  * @} MemAlloc
  */
@@ -20,7 +20,8 @@
 typedef enum {
   PI_FREQ_DOMAIN_FC     = 0,
   PI_FREQ_DOMAIN_CL     = 1,
-  PI_FREQ_DOMAIN_PERIPH = 2
+  PI_FREQ_DOMAIN_PERIPH = 2,
+  PI_FREQ_DOMAIN_NB
 } pi_freq_domain_e;
 
 /**
@@ -45,4 +46,146 @@ static inline uint32_t pi_freq_get(pi_freq_domain_e domain);
  */
 static inline int32_t pi_freq_set(pi_freq_domain_e domain, uint32_t freq);
 
+/**
+ * \brief Frequency change notifier structure.
+ *
+ * This structure is used by the runtime to manage a callback called on
+ * frequency changes. It must be kept alive until the notifier is removed.
+ */
+typedef struct pi_freq_notifier_s pi_freq_notifier_t;
+
+/**
+ * \brief Register a callback for frequency changes.
+ *
+ * The callback is called each time the frequency of the domain is changed,
+ * either by pi_freq_set or by the governor, after the new frequency is
+ * applied. This is typically used by drivers to re-derive their baudrates.
+ *
+ * \param     notifier The notifier structure.
+ * \param     domain   The frequency domain.
+ * \param     callback The callback, receiving the argument, the old and the
+ *                     new frequencies in Hz.
+ * \param     arg      The argument given to the callback.
+ */
+void pi_freq_notifier_add(pi_freq_notifier_t *notifier,
+                          pi_freq_domain_e domain,
+                          void (*callback)(void *arg, uint32_t old_freq,
+                                           uint32_t new_freq),
+                          void *arg);
+
+/**
+ * \brief Unregister a frequency change callback.
+ *
+ * \param     notifier The notifier structure.
+ */
+void pi_freq_notifier_remove(pi_freq_notifier_t *notifier);
+
+/**
+ * \brief Maximum number of frequency levels of the governor.
+ */
+#define PI_FREQ_GOV_MAX_LEVELS 8
+
+/**
+ * \brief Frequency governor configuration structure.
+ *
+ * Loads are given in percent. The governor only uses nb_levels frequencies
+ * for each domain, evenly spaced from the minimum to the maximum frequency.
+ */
+struct pi_freq_gov_conf
+{
+    uint32_t period_us;     /*!< Period at which the governor re-evaluates
+                              the frequencies. */
+    uint32_t min_freq[PI_FREQ_DOMAIN_NB]; /*!< Minimum frequency of each
+                              domain, in Hz. */
+    uint32_t max_freq[PI_FREQ_DOMAIN_NB]; /*!< Maximum frequency of each
+                              domain, in Hz. */
+    uint8_t nb_levels;      /*!< Number of frequency levels of each domain,
+                              from 2 to PI_FREQ_GOV_MAX_LEVELS. */
+    uint8_t up_load;        /*!< Load above which the frequency of a domain
+                              is raised. */
+    uint8_t down_load;      /*!< Load below which the frequency of a domain
+                              is lowered. */
+    uint8_t queue_depth;    /*!< Number of pending tasks in the event kernel
+                              above which the FC frequency is raised. */
+};
+
+/**
+ * \brief Frequency governor statistics.
+ *
+ * The time spent at each frequency level, together with the power of the
+ * chip at each frequency, gives the energy spent, while missed_deadlines
+ * gives the latency cost of the chosen frequencies.
+ */
+struct pi_freq_gov_stats
+{
+    uint32_t changes;          /*!< Number of frequency changes. */
+    uint32_t missed_deadlines; /*!< Number of deadlines which were missed. */
+    uint32_t level_freq[PI_FREQ_DOMAIN_NB][PI_FREQ_GOV_MAX_LEVELS]; /*!<
+                                 Frequency of each level of each domain, in
+                                 Hz. */
+    uint64_t time_us[PI_FREQ_DOMAIN_NB][PI_FREQ_GOV_MAX_LEVELS]; /*!< Time
+                                 spent at each level of each domain, in
+                                 micro-seconds. */
+};
+
+/**
+ * \brief Initialize a governor configuration with default values.
+ *
+ * \param     conf     The governor configuration.
+ */
+void pi_freq_gov_conf_init(struct pi_freq_gov_conf *conf);
+
+/**
+ * \brief Start the frequency governor.
+ *
+ * Once started, the governor periodically observes the load of each domain,
+ * which is the depth of the event kernel queue for the FC, the utilization
+ * of the cluster cores measured with the performance counters, and the
+ * activity of the peripherals, as well as the slack of the declared
+ * deadlines. It then raises or lowers the frequency of each domain within the
+ * configured bounds with pi_freq_set.
+ *
+ * \param     conf     The governor configuration. It must be kept alive
+ *                     until the governor is stopped.
+ * \return             0 if successfull, -1 otherwise.
+ */
+int pi_freq_gov_start(struct pi_freq_gov_conf *conf);
+
+/**
+ * \brief Stop the frequency governor.
+ *
+ * The current frequencies are kept.
+ */
+void pi_freq_gov_stop(void);
+
+/**
+ * \brief Declare a deadline to the frequency governor.
+ *
+ * This tells the governor that the specified amount of work must be finished
+ * within the specified time. The governor sets the frequency of the domain to
+ * the lowest level at which work_cycles fits before the deadline, raising it
+ * immediately if needed, without waiting for the next period.
+ *
+ * \param     domain      The frequency domain executing the work.
+ * \param     deadline_us Time from now to the deadline, in micro-seconds.
+ * \param     work_cycles Estimated number of cycles of the domain needed to
+ *                        execute the work.
+ */
+void pi_freq_gov_deadline_set(pi_freq_domain_e domain, uint32_t deadline_us,
+                              uint32_t work_cycles);
+
+/**
+ * \brief Notify the frequency governor that the declared work is done.
+ *
+ * \param     domain      The frequency domain executing the work.
+ */
+void pi_freq_gov_deadline_done(pi_freq_domain_e domain);
+
+/**
+ * \brief Get the frequency governor statistics.
+ *
+ * \param     stats    The structure where the statistics are stored.
+ */
+void pi_freq_gov_stats_get(struct pi_freq_gov_stats *stats);
+
 #endif  /* __PMSIS_FREQ_H__ */
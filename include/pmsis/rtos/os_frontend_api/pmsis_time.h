@@ -17,6 +17,140 @@
 #ifndef __PMSIS_TIME_H__
 #define __PMSIS_TIME_H__
 
+#include <stdint.h>
+
+/**
+ * @ingroup groupRTOS
+ *
+ * @defgroup Time Time management
+ *
+ * \brief Time measurement and waiting.
+ *
+ * This part provides a monotonic time base common to all the runtime, which
+ * can be used for profiling and tracing, as well as functions to wait for
+ * a given amount of time.
+ *
+ * @addtogroup Time
+ * @{
+ */
+
+/**
+ * \brief Policy used to wait.
+ */
+typedef enum
+{
+    PI_TIME_WAIT_AUTO  = 0, /*!< Busy-wait for short durations, sleep for
+                              long ones. This is the default. */
+    PI_TIME_WAIT_BUSY  = 1, /*!< Always busy-wait. This is the most accurate
+                              but keeps the core active. */
+    PI_TIME_WAIT_SLEEP = 2  /*!< Always sleep until a timer wakes up the
+                              core. */
+} pi_time_wait_policy_e;
+
+/**
+ * \brief Get the current time in micro-seconds.
+ *
+ * The time is monotonic and starts when the runtime is started. It is not
+ * affected by frequency changes.
+ *
+ * \return               The current time in micro-seconds.
+ */
+uint64_t pi_time_get_us(void);
+
+/**
+ * \brief Get the current time in FC cycles.
+ *
+ * This is the cheapest way to get a timestamp, but the duration of a cycle
+ * depends on the current FC frequency. For measurements spanning a frequency
+ * change, pi_time_get_us should be used instead.
+ *
+ * \return               The current time in FC cycles.
+ */
+uint64_t pi_time_get_cycles(void);
+
+/**
+ * \brief Convert a number of FC cycles to micro-seconds.
+ *
+ * The conversion is done with the current FC frequency. With an FC
+ * frequency of at least 1 MHz, the result is exact whenever it fits in 64
+ * bits.
+ *
+ * \param cycles         Number of cycles.
+ *
+ * \return               The corresponding number of micro-seconds.
+ */
+static inline uint64_t pi_time_cycles_to_us(uint64_t cycles);
+
+/**
+ * \brief Convert a number of micro-seconds to FC cycles.
+ *
+ * The conversion is done with the current FC frequency. With an FC
+ * frequency of at least 1 MHz, the result is exact whenever it fits in 64
+ * bits.
+ *
+ * \param time_us        Number of micro-seconds.
+ *
+ * \return               The corresponding number of cycles.
+ */
+static inline uint64_t pi_time_us_to_cycles(uint64_t time_us);
+
+/**
+ * \brief Wait for a given amount of time.
+ *
+ * The caller is blocked for at least the specified number of micro-seconds.
+ * Depending on the wait policy, the core is either busy-waiting or sleeping.
+ *
+ * \param time_us        Number of micro-seconds to wait.
+ */
 void pi_time_wait_us(int time_us);
 
+/**
+ * \brief Set the policy used by pi_time_wait_us.
+ *
+ * With PI_TIME_WAIT_AUTO, waits shorter than the threshold are done with a
+ * busy-wait, as sleeping would cost more than the wait itself, and longer
+ * waits are done by sleeping.
+ *
+ * \param policy         The wait policy.
+ * \param threshold_us   Threshold used with PI_TIME_WAIT_AUTO. If it is 0,
+ *                       the value measured by pi_time_wait_calibrate is used.
+ */
+void pi_time_wait_policy_set(pi_time_wait_policy_e policy,
+                             uint32_t threshold_us);
+
+/**
+ * \brief Calibrate the busy-wait threshold.
+ *
+ * This measures the overhead of a sleeping wait, which is the time needed to
+ * program the timer, go to sleep and wake up, and uses it as threshold for
+ * PI_TIME_WAIT_AUTO. This should be called again after a frequency change.
+ *
+ * \return               The measured threshold in micro-seconds.
+ */
+uint32_t pi_time_wait_calibrate(void);
+
+/**
+ * @}
+ */
+
+/// @cond IMPLEM
+
+/*
+ * Generic conversions, to be used by the backends to implement
+ * pi_time_cycles_to_us and pi_time_us_to_cycles once pi_freq_get is defined.
+ * The division is split so that the intermediate products do not overflow.
+ * For freq >= 1 MHz, the result is exact whenever it fits in 64 bits.
+ */
+static inline uint64_t __pi_time_cycles_to_us(uint64_t cycles, uint32_t freq)
+{
+    return (cycles / freq) * 1000000 + ((cycles % freq) * 1000000) / freq;
+}
+
+static inline uint64_t __pi_time_us_to_cycles(uint64_t time_us, uint32_t freq)
+{
+    return (time_us / 1000000) * freq + ((time_us % 1000000) * freq) / 1000000;
+}
+
+/// @endcond
+
 #endif  /* __PMSIS_TIME_H__ */